@@ -0,0 +1,151 @@
+#include "manager_harness.hpp"
+
+#include <linux/if_addr.h>
+#include <linux/neighbour.h>
+#include <linux/rtnetlink.h>
+#include <sys/resource.h>
+
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+namespace phosphor::network::bench
+{
+
+static long peakRssKiB()
+{
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+/** @brief Runs one event stream per iteration against a fresh manager.
+ *         Only the stream is timed, not the setup or teardown.
+ */
+template <typename Setup, typename Stream>
+static void scale(benchmark::State& state, Setup&& setup, Stream&& stream)
+{
+    size_t events = 0;
+    size_t signals = 0;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto h = std::make_unique<Harness>();
+        setup(*h);
+        auto startEvents = h->events;
+        auto startSignals = h->sdbus.signals;
+        state.ResumeTiming();
+
+        stream(*h);
+
+        state.PauseTiming();
+        events += h->events - startEvents;
+        signals += h->sdbus.signals - startSignals;
+        h.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(events);
+    state.counters["events"] = benchmark::Counter(
+        events, benchmark::Counter::kAvgIterations);
+    state.counters["signals/event"] =
+        events == 0 ? 0.0 : static_cast<double>(signals) / events;
+    state.counters["peak_rss_MiB"] = peakRssKiB() / 1024.0;
+}
+
+static void BM_AddVlans(benchmark::State& state)
+{
+    size_t n = state.range(0);
+    scale(state, parent, [&](Harness& h) {
+        for (uint16_t id = 1; id <= n; ++id)
+        {
+            h.link(vlan(id));
+        }
+    });
+}
+BENCHMARK(BM_AddVlans)->Arg(256)->Arg(4094)->Unit(benchmark::kMillisecond);
+
+static void BM_RemoveVlans(benchmark::State& state)
+{
+    size_t n = state.range(0);
+    scale(
+        state, [&](Harness& h) { vlans(h, n); },
+        [&](Harness& h) {
+            for (uint16_t id = 1; id <= n; ++id)
+            {
+                h.manager.removeInterface(vlan(id));
+                h.events++;
+            }
+        });
+}
+BENCHMARK(BM_RemoveVlans)->Arg(4094)->Unit(benchmark::kMillisecond);
+
+static void BM_AddAddresses(benchmark::State& state)
+{
+    constexpr unsigned intfs = 16;
+    size_t n = state.range(0);
+    scale(
+        state,
+        [&](Harness& h) {
+            for (unsigned i = 0; i < intfs; ++i)
+            {
+                h.link(ether(parentIdx + i));
+            }
+        },
+        [&](Harness& h) {
+            for (uint32_t i = 0; i < n; ++i)
+            {
+                stdplus::InAnyAddr addr = ip4(i);
+                uint8_t pfx = 8;
+                if (i % 2 != 0)
+                {
+                    addr = ip6(i);
+                    pfx = 64;
+                }
+                AddressInfo info{.ifidx = parentIdx + i % intfs,
+                                 .ifaddr = stdplus::SubnetAny{addr, pfx},
+                                 .scope = RT_SCOPE_UNIVERSE,
+                                 .flags = IFA_F_PERMANENT};
+                h.manager.addAddress(info);
+                h.events++;
+            }
+        });
+}
+BENCHMARK(BM_AddAddresses)->Arg(20000)->Unit(benchmark::kMillisecond);
+
+static void BM_AddStaticNeighbors(benchmark::State& state)
+{
+    size_t n = state.range(0);
+    scale(state, parent, [&](Harness& h) {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            h.manager.addNeighbor(NeighborInfo{
+                .ifidx = parentIdx,
+                .state = NUD_PERMANENT,
+                .addr = ip4(i),
+                .mac = stdplus::EtherAddr{0x02, 1, 0, uint8_t(i >> 16),
+                                          uint8_t(i >> 8), uint8_t(i)}});
+            h.events++;
+        }
+    });
+}
+BENCHMARK(BM_AddStaticNeighbors)->Arg(5000)->Unit(benchmark::kMillisecond);
+
+static void BM_AddDefaultGateways(benchmark::State& state)
+{
+    size_t n = state.range(0);
+    scale(
+        state, [&](Harness& h) { vlans(h, n); },
+        [&](Harness& h) {
+            for (uint16_t id = 1; id <= n; ++id)
+            {
+                h.manager.addDefGw(firstVlanIdx + id, ip4(id));
+                h.manager.addDefGw(firstVlanIdx + id, ip6(id));
+                h.events += 2;
+            }
+        });
+}
+BENCHMARK(BM_AddDefaultGateways)->Arg(4094)->Unit(benchmark::kMillisecond);
+
+} // namespace phosphor::network::bench
+
+BENCHMARK_MAIN();
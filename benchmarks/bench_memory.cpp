@@ -0,0 +1,133 @@
+#include "alloc_count.hpp"
+#include "manager_harness.hpp"
+#include "statistics.hpp"
+
+#include <linux/if_addr.h>
+#include <linux/neighbour.h>
+#include <linux/rtnetlink.h>
+
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+namespace phosphor::network::bench
+{
+
+/** @brief Memory accounting of the process at a point in time */
+struct Footprint
+{
+    double newBytes;
+    double heapBytes;
+    double rssBytes;
+    double allocs;
+    double objects;
+
+    static Footprint sample()
+    {
+        double objects = 0;
+        for (const auto& [_, n] : stats::get().objectSnapshot())
+        {
+            objects += n;
+        }
+        return Footprint{.newBytes = static_cast<double>(liveBytes()),
+                         .heapBytes = static_cast<double>(stats::heapBytes()),
+                         .rssBytes =
+                             static_cast<double>(stats::residentBytes()),
+                         .allocs = static_cast<double>(allocations()),
+                         .objects = objects};
+    }
+};
+
+/** @brief Adds n objects per iteration to a fresh manager and reports how
+ *         much memory each one costs. The operator new hook gives the bytes
+ *         held by C++ objects, mallinfo the whole heap including sd-bus, and
+ *         the RSS what the kernel actually had to back.
+ */
+template <typename Setup, typename Add>
+static void footprint(benchmark::State& state, Setup&& setup, Add&& add)
+{
+    size_t n = state.range(0);
+    Footprint total{};
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto h = std::make_unique<Harness>();
+        setup(*h);
+        auto before = Footprint::sample();
+        state.ResumeTiming();
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            add(*h, i);
+        }
+
+        state.PauseTiming();
+        auto after = Footprint::sample();
+        total.newBytes += after.newBytes - before.newBytes;
+        total.heapBytes += after.heapBytes - before.heapBytes;
+        total.rssBytes += after.rssBytes - before.rssBytes;
+        total.allocs += after.allocs - before.allocs;
+        total.objects += after.objects - before.objects;
+        h.reset();
+        state.ResumeTiming();
+    }
+    double objs = static_cast<double>(state.iterations()) * n;
+    state.counters["new_B/obj"] = total.newBytes / objs;
+    state.counters["heap_B/obj"] = total.heapBytes / objs;
+    state.counters["rss_B/obj"] = total.rssBytes / objs;
+    state.counters["allocs/obj"] = total.allocs / objs;
+    state.counters["dbus_objs/obj"] = total.objects / objs;
+}
+
+static void BM_VlanFootprint(benchmark::State& state)
+{
+    footprint(state, parent,
+              [](Harness& h, size_t i) { h.link(vlan(i + 1)); });
+}
+BENCHMARK(BM_VlanFootprint)
+    ->Arg(512)
+    ->Arg(4094)
+    ->Iterations(3)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_AddressFootprint(benchmark::State& state)
+{
+    footprint(state, parent, [](Harness& h, size_t i) {
+        stdplus::InAnyAddr addr = ip4(i);
+        uint8_t pfx = 8;
+        if (i % 2 != 0)
+        {
+            addr = ip6(i);
+            pfx = 64;
+        }
+        h.manager.addAddress(
+            AddressInfo{.ifidx = parentIdx,
+                        .ifaddr = stdplus::SubnetAny{addr, pfx},
+                        .scope = RT_SCOPE_UNIVERSE,
+                        .flags = IFA_F_PERMANENT});
+    });
+}
+BENCHMARK(BM_AddressFootprint)
+    ->Arg(4096)
+    ->Iterations(3)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_NeighborFootprint(benchmark::State& state)
+{
+    footprint(state, parent, [](Harness& h, size_t i) {
+        h.manager.addNeighbor(NeighborInfo{
+            .ifidx = parentIdx,
+            .state = NUD_PERMANENT,
+            .addr = ip4(i),
+            .mac = stdplus::EtherAddr{0x02, 1, 0, uint8_t(i >> 16),
+                                      uint8_t(i >> 8), uint8_t(i)}});
+    });
+}
+BENCHMARK(BM_NeighborFootprint)
+    ->Arg(4096)
+    ->Iterations(3)
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace phosphor::network::bench
+
+BENCHMARK_MAIN();
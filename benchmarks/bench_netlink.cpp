@@ -0,0 +1,283 @@
+#include "alloc_count.hpp"
+#include "netlink.hpp"
+#include "netlink_msg.hpp"
+#include "rtnetlink.hpp"
+
+#include <arpa/inet.h>
+#include <linux/if_addr.h>
+#include <linux/if_vlan.h>
+#include <linux/if_link.h>
+#include <linux/neighbour.h>
+#include <net/if.h>
+#include <net/if_arp.h>
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+#include <benchmark/benchmark.h>
+
+namespace phosphor::network::bench
+{
+
+using netlink::MsgBuilder;
+using std::literals::string_view_literals::operator""sv;
+
+constexpr std::array<uint8_t, 6> mac = {0x02, 0x00, 0x5e, 0x10, 0x20, 0x30};
+constexpr std::array<uint8_t, 4> ip4 = {192, 168, 1, 20};
+constexpr std::array<uint8_t, 16> ip6 = {0xfd, 0x00, 0, 0, 0, 0, 0, 0,
+                                         0x02, 0x00, 0x5e, 0xff,
+                                         0xfe, 0x10, 0x20, 0x30};
+
+/** @brief Runs the benchmark loop and reports the per message cost, where
+ *         each iteration handles msgsPerIter messages.
+ */
+template <typename F>
+static void perMsg(benchmark::State& state, size_t msgsPerIter, F&& f)
+{
+    auto allocsStart = allocations();
+    for (auto _ : state)
+    {
+        f();
+    }
+    auto allocs = allocations() - allocsStart;
+    auto msgs = static_cast<double>(state.iterations() * msgsPerIter);
+    state.SetItemsProcessed(state.iterations() * msgsPerIter);
+    // Reported in seconds, so shown with an SI prefix like 12.3ns
+    state.counters["time/msg"] = benchmark::Counter(
+        msgs, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    state.counters["allocs/msg"] = static_cast<double>(allocs) / msgs;
+}
+
+static void smallLink(MsgBuilder& b, unsigned idx)
+{
+    ifinfomsg ifi{};
+    ifi.ifi_type = ARPHRD_ETHER;
+    ifi.ifi_index = idx;
+    ifi.ifi_flags = IFF_UP | IFF_RUNNING;
+    b.begin(RTM_NEWLINK).data(ifi);
+    b.str(IFLA_IFNAME, "eth0"sv).attr(IFLA_MTU, 1500u).end();
+}
+
+/** @brief A link as a full kernel dump reports it, statistics included */
+static void largeLink(MsgBuilder& b, unsigned idx)
+{
+    ifinfomsg ifi{};
+    ifi.ifi_type = ARPHRD_ETHER;
+    ifi.ifi_index = idx;
+    ifi.ifi_flags = IFF_UP | IFF_RUNNING | IFF_BROADCAST | IFF_MULTICAST;
+    b.begin(RTM_NEWLINK, NLM_F_MULTI).data(ifi);
+    b.str(IFLA_IFNAME, "eth0"sv);
+    b.attr(IFLA_TXQLEN, 1000u);
+    b.attr(IFLA_OPERSTATE, uint8_t{6});
+    b.attr(IFLA_LINKMODE, uint8_t{0});
+    b.attr(IFLA_MTU, 1500u);
+    b.attr(IFLA_MIN_MTU, 68u);
+    b.attr(IFLA_MAX_MTU, 9000u);
+    b.attr(IFLA_GROUP, 0u);
+    b.attr(IFLA_PROMISCUITY, 0u);
+    b.attr(IFLA_NUM_TX_QUEUES, 8u);
+    b.attr(IFLA_GSO_MAX_SEGS, 65535u);
+    b.attr(IFLA_GSO_MAX_SIZE, 65536u);
+    b.attr(IFLA_NUM_RX_QUEUES, 8u);
+    b.attr(IFLA_CARRIER, uint8_t{1});
+    b.str(IFLA_QDISC, "mq"sv);
+    b.attr(IFLA_CARRIER_CHANGES, 2u);
+    b.attr(IFLA_PROTO_DOWN, uint8_t{0});
+    b.attr(IFLA_MAP, rtnl_link_ifmap{});
+    b.attr(IFLA_ADDRESS, mac);
+    b.attr(IFLA_BROADCAST, std::array<uint8_t, 6>{0xff, 0xff, 0xff, 0xff,
+                                                  0xff, 0xff});
+    b.attr(IFLA_STATS64, rtnl_link_stats64{});
+    b.attr(IFLA_STATS, rtnl_link_stats{});
+    b.nest(IFLA_AF_SPEC);
+    b.nest(AF_INET6);
+    b.attr(IFLA_INET6_FLAGS, 0x80000000u);
+    b.attr(IFLA_INET6_CONF, std::array<uint32_t, 56>{});
+    b.attr(IFLA_INET6_STATS, std::array<uint64_t, 37>{});
+    b.endNest();
+    b.endNest();
+    b.end();
+}
+
+static void vlanLink(MsgBuilder& b, unsigned idx, uint16_t id)
+{
+    ifinfomsg ifi{};
+    ifi.ifi_type = ARPHRD_ETHER;
+    ifi.ifi_index = idx;
+    ifi.ifi_flags = IFF_UP | IFF_RUNNING;
+    b.begin(RTM_NEWLINK).data(ifi);
+    b.str(IFLA_IFNAME, "eth0.100"sv);
+    b.attr(IFLA_MTU, 1500u);
+    b.attr(IFLA_LINK, 2u);
+    b.attr(IFLA_ADDRESS, mac);
+    b.nest(IFLA_LINKINFO);
+    b.str(IFLA_INFO_KIND, "vlan"sv);
+    b.nest(IFLA_INFO_DATA);
+    b.attr(IFLA_VLAN_PROTOCOL, htons(0x8100));
+    b.attr(IFLA_VLAN_ID, id);
+    b.attr(IFLA_VLAN_FLAGS, ifla_vlan_flags{VLAN_FLAG_REORDER_HDR, ~0u});
+    b.endNest();
+    b.endNest();
+    b.end();
+}
+
+static void addr4(MsgBuilder& b, unsigned idx, uint16_t flags = 0)
+{
+    ifaddrmsg ifa{};
+    ifa.ifa_family = AF_INET;
+    ifa.ifa_prefixlen = 24;
+    ifa.ifa_flags = IFA_F_PERMANENT;
+    ifa.ifa_index = idx;
+    b.begin(RTM_NEWADDR, flags).data(ifa);
+    b.attr(IFA_ADDRESS, ip4).attr(IFA_LOCAL, ip4);
+    b.attr(IFA_BROADCAST, std::array<uint8_t, 4>{192, 168, 1, 255});
+    b.str(IFA_LABEL, "eth0"sv);
+    b.attr(IFA_FLAGS, uint32_t{IFA_F_PERMANENT});
+    b.attr(IFA_CACHEINFO, ifa_cacheinfo{});
+    b.end();
+}
+
+static void addr6(MsgBuilder& b, unsigned idx)
+{
+    ifaddrmsg ifa{};
+    ifa.ifa_family = AF_INET6;
+    ifa.ifa_prefixlen = 64;
+    ifa.ifa_flags = IFA_F_PERMANENT;
+    ifa.ifa_index = idx;
+    b.begin(RTM_NEWADDR).data(ifa);
+    b.attr(IFA_ADDRESS, ip6);
+    b.attr(IFA_CACHEINFO, ifa_cacheinfo{});
+    b.attr(IFA_FLAGS, uint32_t{IFA_F_PERMANENT | IFA_F_NOPREFIXROUTE});
+    b.end();
+}
+
+template <size_t N>
+static void neigh(MsgBuilder& b, uint8_t family,
+                  const std::array<uint8_t, N>& dst)
+{
+    ndmsg ndm{};
+    ndm.ndm_family = family;
+    ndm.ndm_ifindex = 2;
+    ndm.ndm_state = NUD_REACHABLE;
+    b.begin(RTM_NEWNEIGH).data(ndm);
+    b.attr(NDA_DST, dst).attr(NDA_LLADDR, mac);
+    b.attr(NDA_PROBES, 0u).attr(NDA_CACHEINFO, nda_cacheinfo{});
+    b.end();
+}
+
+template <size_t N>
+static void gateway(MsgBuilder& b, uint8_t family,
+                    const std::array<uint8_t, N>& gw)
+{
+    rtmsg rtm{};
+    rtm.rtm_family = family;
+    rtm.rtm_table = RT_TABLE_MAIN;
+    rtm.rtm_protocol = RTPROT_STATIC;
+    rtm.rtm_scope = RT_SCOPE_UNIVERSE;
+    rtm.rtm_type = RTN_UNICAST;
+    b.begin(RTM_NEWROUTE).data(rtm);
+    b.attr(RTA_TABLE, uint32_t{RT_TABLE_MAIN});
+    b.attr(RTA_PRIORITY, 1024u);
+    b.attr(RTA_GATEWAY, gw);
+    b.attr(RTA_OIF, 2);
+    if (family == AF_INET6)
+    {
+        b.attr(RTA_PREF, uint8_t{0});
+    }
+    b.end();
+}
+
+static void BM_ProcessMsg(benchmark::State& state)
+{
+    // A single datagram of a multipart address dump
+    MsgBuilder b;
+    size_t n = state.range(0);
+    for (size_t i = 0; i < n; ++i)
+    {
+        addr4(b, i + 1, NLM_F_MULTI);
+    }
+    b.done();
+    size_t calls = 0;
+    auto cb = [&](const nlmsghdr&, std::string_view) { calls++; };
+    perMsg(state, n + 1, [&] {
+        auto msgs = b.msgs();
+        bool done = true;
+        do
+        {
+            netlink::detail::processMsg(msgs, done, cb);
+        } while (!done && !msgs.empty());
+        benchmark::DoNotOptimize(calls);
+    });
+}
+BENCHMARK(BM_ProcessMsg)->Arg(1)->Arg(16)->Arg(64);
+
+static void BM_ExtractRtAttr(benchmark::State& state)
+{
+    MsgBuilder b;
+    largeLink(b, 2);
+    auto attrs = b.payload().substr(NLMSG_ALIGN(sizeof(ifinfomsg)));
+    size_t n = 0;
+    for (auto data = attrs; !data.empty(); ++n)
+    {
+        netlink::extractRtAttr(data);
+    }
+    state.SetLabel("per attribute");
+    perMsg(state, n, [&] {
+        auto data = attrs;
+        while (!data.empty())
+        {
+            benchmark::DoNotOptimize(netlink::extractRtAttr(data));
+        }
+    });
+}
+BENCHMARK(BM_ExtractRtAttr);
+
+template <typename Build, typename Parse>
+static void parseOne(benchmark::State& state, Build&& build, Parse&& parse)
+{
+    MsgBuilder b;
+    build(b);
+    auto payload = b.payload();
+    perMsg(state, 1, [&] { benchmark::DoNotOptimize(parse(payload)); });
+}
+
+static void BM_IntfFromRtm(benchmark::State& state, auto build)
+{
+    parseOne(state, build, netlink::intfFromRtm);
+}
+BENCHMARK_CAPTURE(BM_IntfFromRtm, small,
+                  [](MsgBuilder& b) { smallLink(b, 2); });
+BENCHMARK_CAPTURE(BM_IntfFromRtm, large,
+                  [](MsgBuilder& b) { largeLink(b, 2); });
+BENCHMARK_CAPTURE(BM_IntfFromRtm, vlan,
+                  [](MsgBuilder& b) { vlanLink(b, 3, 100); });
+
+static void BM_AddrFromRtm(benchmark::State& state, auto build)
+{
+    parseOne(state, build, netlink::addrFromRtm);
+}
+BENCHMARK_CAPTURE(BM_AddrFromRtm, ipv4, [](MsgBuilder& b) { addr4(b, 2); });
+BENCHMARK_CAPTURE(BM_AddrFromRtm, ipv6, [](MsgBuilder& b) { addr6(b, 2); });
+
+static void BM_NeighFromRtm(benchmark::State& state, auto build)
+{
+    parseOne(state, build, netlink::neighFromRtm);
+}
+BENCHMARK_CAPTURE(BM_NeighFromRtm, ipv4,
+                  [](MsgBuilder& b) { neigh(b, AF_INET, ip4); });
+BENCHMARK_CAPTURE(BM_NeighFromRtm, ipv6,
+                  [](MsgBuilder& b) { neigh(b, AF_INET6, ip6); });
+
+static void BM_GatewayFromRtm(benchmark::State& state, auto build)
+{
+    parseOne(state, build, netlink::gatewayFromRtm);
+}
+BENCHMARK_CAPTURE(BM_GatewayFromRtm, ipv4,
+                  [](MsgBuilder& b) { gateway(b, AF_INET, ip4); });
+BENCHMARK_CAPTURE(BM_GatewayFromRtm, ipv6,
+                  [](MsgBuilder& b) { gateway(b, AF_INET6, ip6); });
+
+} // namespace phosphor::network::bench
+
+BENCHMARK_MAIN();
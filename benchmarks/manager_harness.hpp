@@ -0,0 +1,168 @@
+#pragma once
+#include "network_manager.hpp"
+
+#include <net/if.h>
+#include <net/if_arp.h>
+#include <netinet/in.h>
+
+#include <sdbusplus/test/sdbus_mock.hpp>
+#include <stdplus/pinned.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <string>
+
+#include <gmock/gmock.h>
+
+namespace phosphor::network::bench
+{
+
+using testing::_;
+
+/** @class BenchSdBus
+ *  @brief Mocked sd-bus which accepts everything the manager does and counts
+ *         the signals it would have emitted.
+ */
+class BenchSdBus : public testing::NiceMock<sdbusplus::SdBusMock>
+{
+  public:
+    size_t signals = 0;
+
+    BenchSdBus()
+    {
+        auto emit = [this](auto&&...) {
+            signals++;
+            return 0;
+        };
+        ON_CALL(*this, sd_bus_emit_properties_changed_strv(_, _, _, _))
+            .WillByDefault(emit);
+        ON_CALL(*this, sd_bus_emit_object_added(_, _)).WillByDefault(emit);
+        ON_CALL(*this, sd_bus_emit_object_removed(_, _)).WillByDefault(emit);
+        ON_CALL(*this, sd_bus_emit_interfaces_added_strv(_, _, _))
+            .WillByDefault(emit);
+        ON_CALL(*this, sd_bus_emit_interfaces_removed_strv(_, _, _))
+            .WillByDefault(emit);
+
+        // Queries to other daemons are never answered
+        ON_CALL(*this, sd_bus_message_new_method_call(_, _, _, _, _, _))
+            .WillByDefault(testing::DoAll(testing::SetArgPointee<1>(nullptr),
+                                          testing::Return(0)));
+        ON_CALL(*this, sd_bus_call_async(_, _, _, _, _, _))
+            .WillByDefault(testing::DoAll(testing::SetArgPointee<1>(nullptr),
+                                          testing::Return(0)));
+    }
+};
+
+struct NullExecutor : DelayedExecutor
+{
+    NullExecutor() = default;
+    NullExecutor(NullExecutor&&) = delete;
+
+    void schedule() override {}
+    void setCallback(fu2::unique_function<void()>&&) override {}
+};
+
+struct BenchManager : Manager
+{
+    using Manager::handleAdminState;
+    using Manager::Manager;
+};
+
+inline const std::filesystem::path& confDir()
+{
+    static const auto dir = [] {
+        auto tmpl = (std::filesystem::temp_directory_path() /
+                     "phosphor-networkd-bench.XXXXXX")
+                        .string();
+        if (mkdtemp(tmpl.data()) == nullptr)
+        {
+            std::perror("mkdtemp");
+            std::exit(1);
+        }
+        std::atexit([] { std::filesystem::remove_all(confDir()); });
+        return std::filesystem::path(tmpl);
+    }();
+    return dir;
+}
+
+/** @brief A manager on a mocked bus, holding everything it references */
+struct Harness
+{
+    BenchSdBus sdbus;
+    NullExecutor reload;
+    stdplus::Pinned<sdbusplus::bus_t> bus;
+    BenchManager manager;
+    size_t events = 0;
+
+    Harness() :
+        bus(sdbusplus::get_mocked_new(&sdbus)),
+        manager(bus, reload, "/xyz/openbmc_test/network", confDir())
+    {}
+
+    void link(const InterfaceInfo& info)
+    {
+        manager.addInterface(info);
+        manager.handleAdminState("managed", info.idx);
+        events += 2;
+    }
+};
+
+constexpr unsigned parentIdx = 2;
+constexpr unsigned firstVlanIdx = 100;
+
+inline InterfaceInfo ether(unsigned idx)
+{
+    return InterfaceInfo{
+        .type = ARPHRD_ETHER,
+        .idx = idx,
+        .flags = IFF_UP | IFF_RUNNING,
+        .name = std::format("eth{}", idx - parentIdx),
+        .mac = stdplus::EtherAddr{0x02, 0, 0, 0, 0, uint8_t(idx)},
+        .mtu = 1500};
+}
+
+inline InterfaceInfo vlan(uint16_t id)
+{
+    auto idx = firstVlanIdx + id;
+    return InterfaceInfo{
+        .type = ARPHRD_ETHER,
+        .idx = idx,
+        .flags = IFF_UP | IFF_RUNNING,
+        .name = std::format("eth0.{}", id),
+        .mac = stdplus::EtherAddr{0x02, 0, 0, 0, 0, uint8_t(parentIdx)},
+        .mtu = 1500,
+        .parent_idx = parentIdx,
+        .kind = "vlan",
+        .vlan_id = id};
+}
+
+inline stdplus::In4Addr ip4(uint32_t i)
+{
+    return in_addr{htonl(0x0a000000 | i)};
+}
+
+inline stdplus::In6Addr ip6(uint32_t i)
+{
+    in6_addr ret{};
+    ret.s6_addr[0] = 0xfd;
+    ret.s6_addr32[3] = htonl(i);
+    return ret;
+}
+
+inline void parent(Harness& h)
+{
+    h.link(ether(parentIdx));
+}
+
+inline void vlans(Harness& h, size_t n)
+{
+    parent(h);
+    for (uint16_t id = 1; id <= n; ++id)
+    {
+        h.link(vlan(id));
+    }
+}
+
+} // namespace phosphor::network::bench
@@ -0,0 +1,113 @@
+#include "config.h"
+
+#include "apply_tracker.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+#include <sdeventplus/event.hpp>
+
+#include <algorithm>
+
+namespace phosphor
+{
+namespace network
+{
+
+static auto toMs(stats::Clock::duration d) noexcept
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(d).count();
+}
+
+static std::string keyToStr(const ApplyTracker::Key& key)
+{
+    return std::visit([](const auto& v) { return stdplus::toStr(v); }, key);
+}
+
+ApplyTracker::ApplyTracker() :
+    timer(sdeventplus::Event::get_default(), [this](Timer&) { sweep(); })
+{}
+
+void ApplyTracker::expect(stats::ApplyOp op, unsigned ifidx, const Key& key)
+{
+    auto now = stats::Clock::now();
+    auto it = std::find_if(pending.begin(), pending.end(), [&](const auto& p) {
+        return p.ifidx == ifidx && p.key == key;
+    });
+    if (it != pending.end())
+    {
+        it->op = op;
+        it->start = now;
+    }
+    else
+    {
+        pending.push_back(Pending{op, ifidx, key, now});
+    }
+    if (!timer.isEnabled())
+    {
+        timer.restartOnce(convergeTimeout);
+    }
+}
+
+void ApplyTracker::confirmInt(unsigned ifidx, const Key& key)
+{
+    auto it = std::find_if(pending.begin(), pending.end(), [&](const auto& p) {
+        return p.ifidx == ifidx && p.key == key;
+    });
+    if (it == pending.end())
+    {
+        return;
+    }
+    auto latency = stats::Clock::now() - it->start;
+    auto op = static_cast<size_t>(it->op);
+    stats::get().applyLatency[op].record(latency);
+    if (latency > std::chrono::milliseconds(APPLY_SLO_MS))
+    {
+        lg2::warning("Applying {OP} {VALUE} on {NET_IDX} took {DURATION_MS}ms, "
+                     "exceeding the {SLO_MS}ms SLO",
+                     "OP", stats::applyOpNames[op], "VALUE", keyToStr(key),
+                     "NET_IDX", ifidx, "DURATION_MS", toMs(latency), "SLO_MS",
+                     APPLY_SLO_MS);
+    }
+    pending.erase(it);
+    if (pending.empty())
+    {
+        timer.setEnabled(false);
+    }
+}
+
+void ApplyTracker::forget(unsigned ifidx)
+{
+    std::erase_if(pending, [&](const auto& p) { return p.ifidx == ifidx; });
+    if (pending.empty())
+    {
+        timer.setEnabled(false);
+    }
+}
+
+void ApplyTracker::sweep()
+{
+    auto now = stats::Clock::now();
+    auto oldest = now;
+    std::erase_if(pending, [&](const auto& p) {
+        if (now - p.start < convergeTimeout)
+        {
+            oldest = std::min(oldest, p.start);
+            return false;
+        }
+        auto op = static_cast<size_t>(p.op);
+        stats::add(stats::get().applyNotConverged[op]);
+        lg2::error("Applying {OP} {VALUE} on {NET_IDX} did not converge "
+                   "within {DURATION_MS}ms",
+                   "OP", stats::applyOpNames[op], "VALUE", keyToStr(p.key),
+                   "NET_IDX", p.ifidx, "DURATION_MS", toMs(convergeTimeout));
+        return true;
+    });
+    if (!pending.empty())
+    {
+        timer.restartOnce(
+            std::chrono::ceil<std::chrono::milliseconds>(
+                oldest + convergeTimeout - now));
+    }
+}
+
+} // namespace network
+} // namespace phosphor
@@ -0,0 +1,69 @@
+#pragma once
+#include "statistics.hpp"
+
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/utility/timer.hpp>
+#include <stdplus/net/addr/ip.hpp>
+#include <stdplus/net/addr/subnet.hpp>
+
+#include <variant>
+#include <vector>
+
+namespace phosphor
+{
+namespace network
+{
+
+/** @class ApplyTracker
+ *  @brief Measures how long changes requested over D-Bus take until the
+ *         kernel reports them via rtnetlink.
+ *  @details Changes are only tracked while they are pending, so confirming
+ *           kernel events is free when nothing was requested. Changes that
+ *           are not confirmed in time are flagged as not converged.
+ */
+class ApplyTracker
+{
+  public:
+    using Key = std::variant<stdplus::SubnetAny, stdplus::InAnyAddr>;
+
+    /** @brief How long a change may take before it is considered lost */
+    static constexpr auto convergeTimeout = std::chrono::seconds(60);
+
+    ApplyTracker();
+    ApplyTracker(ApplyTracker&&) = delete;
+    ApplyTracker& operator=(ApplyTracker&&) = delete;
+
+    /** @brief Starts tracking a change that should show up in the kernel */
+    void expect(stats::ApplyOp op, unsigned ifidx, const Key& key);
+
+    /** @brief Completes the matching change once the kernel reports it */
+    inline void confirm(unsigned ifidx, const Key& key)
+    {
+        if (!pending.empty())
+        {
+            confirmInt(ifidx, key);
+        }
+    }
+
+    /** @brief Drops all pending changes of a removed interface */
+    void forget(unsigned ifidx);
+
+  private:
+    using Timer = sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>;
+
+    struct Pending
+    {
+        stats::ApplyOp op;
+        unsigned ifidx;
+        Key key;
+        stats::Clock::time_point start;
+    };
+    std::vector<Pending> pending;
+    Timer timer;
+
+    void confirmInt(unsigned ifidx, const Key& key);
+    void sweep();
+};
+
+} // namespace network
+} // namespace phosphor
@@ -1,5 +1,7 @@
 #include "config_parser.hpp"
 
+#include "statistics.hpp"
+
 #include <stdplus/exception.hpp>
 #include <stdplus/fd/atomic.hpp>
 #include <stdplus/fd/create.hpp>
@@ -7,7 +9,9 @@
 #include <stdplus/fd/line.hpp>
 #include <stdplus/str/cat.hpp>
 
+#include <algorithm>
 #include <format>
+#include <fstream>
 #include <functional>
 #include <iterator>
 #include <stdexcept>
@@ -279,24 +283,42 @@ void Parser::setFile(const fs::path& filename)
 
 static void writeFileInt(const SectionMap& map, const fs::path& filename)
 {
-    stdplus::fd::AtomicWriter writer(filename, 0644);
-    stdplus::fd::FormatBuffer out(writer);
+    std::string contents;
     for (const auto& [section, maps] : map)
     {
         for (const auto& map : maps)
         {
-            out.appends("["sv, section.get(), "]\n"sv);
+            stdplus::strAppend(contents, "["sv, section.get(), "]\n"sv);
             for (const auto& [key, vals] : map)
             {
                 for (const auto& val : vals)
                 {
-                    out.appends(key.get(), "="sv, val.get(), "\n"sv);
+                    stdplus::strAppend(contents, key.get(), "="sv, val.get(),
+                                       "\n"sv);
                 }
             }
         }
     }
+
+    // Avoid wearing the flash when nothing changed
+    {
+        std::ifstream in(filename, std::ios::binary);
+        if (in && std::equal(std::istreambuf_iterator<char>(in),
+                             std::istreambuf_iterator<char>(),
+                             contents.begin(), contents.end()))
+        {
+            stats::add(stats::get().configsSkipped);
+            return;
+        }
+    }
+
+    stdplus::fd::AtomicWriter writer(filename, 0644);
+    stdplus::fd::FormatBuffer out(writer);
+    out.appends(contents);
     out.flush();
     writer.commit();
+    stats::add(stats::get().configsWritten);
+    stats::add(stats::get().configBytesWritten, contents.size());
 }
 
 void Parser::writeFile() const
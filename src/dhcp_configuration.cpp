@@ -19,11 +19,10 @@ using namespace sdbusplus::xyz::openbmc_project::Common::Error;
 
 Configuration::Configuration(
     sdbusplus::bus_t& bus, stdplus::const_zstring objPath,
-    stdplus::PinnedRef<EthernetInterface> parent, DHCPType type) :
+    stdplus::PinnedRef<EthernetInterface> parent, DHCPType type,
+    const config::Parser& conf) :
     Iface(bus, objPath.c_str(), Iface::action::defer_emit), parent(parent)
 {
-    config::Parser conf(config::pathForIntfConf(
-        parent.get().manager.get().getConfDir(), parent.get().interfaceName()));
     ConfigIntf::domainEnabled(getDHCPProp(conf, type, "UseDomains"), true);
     ConfigIntf::dnsEnabled(getDHCPProp(conf, type, "UseDNS"), true);
     ConfigIntf::ntpEnabled(getDHCPProp(conf, type, "UseNTP"), true);
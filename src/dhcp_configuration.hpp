@@ -1,4 +1,5 @@
 #pragma once
+#include "statistics.hpp"
 #include "util.hpp"
 
 #include <sdbusplus/bus.hpp>
@@ -35,9 +36,11 @@ class Configuration : public Iface
      *  @param[in] objPath - Path to attach at.
      *  @param[in] parent - Parent object.
      *  @param[in] type - Network type.
+     *  @param[in] conf - The parsed configuration file of the parent.
      */
     Configuration(sdbusplus::bus_t& bus, stdplus::const_zstring objPath,
-                  stdplus::PinnedRef<EthernetInterface> parent, DHCPType type);
+                  stdplus::PinnedRef<EthernetInterface> parent, DHCPType type,
+                  const config::Parser& conf);
 
     /** @brief If true then DNS servers received from the DHCP server
      *         will be used and take precedence over any statically
@@ -89,6 +92,9 @@ class Configuration : public Iface
   private:
     /** @brief Ethernet Interface object. */
     stdplus::PinnedRef<EthernetInterface> parent;
+
+    [[no_unique_address]] stats::LiveObject<stats::Object::DHCPConfiguration>
+        live;
 };
 
 } // namespace dhcp
@@ -0,0 +1,159 @@
+#include "diagnostics.hpp"
+
+#include "stall_monitor.hpp"
+#include "statistics.hpp"
+
+#include <chrono>
+
+namespace phosphor
+{
+namespace network
+{
+
+static uint64_t toUs(Startup::Clock::duration d) noexcept
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+}
+
+Diagnostics::Diagnostics(sdbusplus::bus_t& bus,
+                         stdplus::const_zstring objPath) :
+    DiagnosticsIfaces(bus, objPath.c_str(),
+                      DiagnosticsIfaces::action::defer_emit)
+{
+    emit_object_added();
+}
+
+void Diagnostics::startupComplete(const Startup& startup)
+{
+    std::map<std::string, uint64_t> phases;
+    for (const auto& p : startup.getPhases())
+    {
+        phases.emplace(p.name, toUs(p.end - p.start));
+    }
+    StartupIntf::phaseDurations(std::move(phases));
+    StartupIntf::totalDuration(toUs(startup.getTotal()));
+    StartupIntf::ready(true);
+}
+
+std::map<std::string, uint64_t> Diagnostics::netlinkMessages() const
+{
+    return stats::get().netlinkSnapshot();
+}
+
+uint64_t Diagnostics::netlinkParseErrors() const
+{
+    return stats::load(stats::get().netlinkParseErrors);
+}
+
+uint64_t Diagnostics::ignoredInterfaceEvents() const
+{
+    return stats::load(stats::get().ignoredIntfEvents);
+}
+
+uint64_t Diagnostics::configFilesWritten() const
+{
+    return stats::load(stats::get().configsWritten);
+}
+
+uint64_t Diagnostics::configFilesSkipped() const
+{
+    return stats::load(stats::get().configsSkipped);
+}
+
+uint64_t Diagnostics::configBytesWritten() const
+{
+    return stats::load(stats::get().configBytesWritten);
+}
+
+uint64_t Diagnostics::reloads() const
+{
+    return stats::load(stats::get().reloads);
+}
+
+std::vector<uint64_t> Diagnostics::reloadLatency() const
+{
+    return stats::get().reloadLatency.snapshot();
+}
+
+uint64_t Diagnostics::signalsEmitted() const
+{
+    return stats::load(stats::get().signalsEmitted);
+}
+
+uint64_t Diagnostics::methodCalls() const
+{
+    return stats::load(stats::get().methodCalls);
+}
+
+std::vector<uint64_t> Diagnostics::methodCallLatency() const
+{
+    return stats::get().methodCallLatency.snapshot();
+}
+
+std::map<std::string, std::vector<uint64_t>> Diagnostics::latency() const
+{
+    std::map<std::string, std::vector<uint64_t>> ret;
+    for (size_t i = 0; i < stats::applyOpNames.size(); ++i)
+    {
+        ret.emplace(stats::applyOpNames[i],
+                    stats::get().applyLatency[i].snapshot());
+    }
+    return ret;
+}
+
+uint64_t Diagnostics::budget() const
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               stall::get().getBudget())
+        .count();
+}
+
+uint64_t Diagnostics::budget(uint64_t value)
+{
+    stall::get().setBudget(std::chrono::milliseconds(value));
+    return StallsIntf::budget(value);
+}
+
+uint64_t Diagnostics::count() const
+{
+    return stall::get().getStalls();
+}
+
+std::vector<std::tuple<std::string, uint64_t>> Diagnostics::slowest() const
+{
+    std::vector<std::tuple<std::string, uint64_t>> ret;
+    for (const auto& e : stall::get().getSlowest())
+    {
+        ret.emplace_back(e.source, toUs(e.duration));
+    }
+    return ret;
+}
+
+std::map<std::string, uint64_t> Diagnostics::notConverged() const
+{
+    std::map<std::string, uint64_t> ret;
+    for (size_t i = 0; i < stats::applyOpNames.size(); ++i)
+    {
+        ret.emplace(stats::applyOpNames[i],
+                    stats::load(stats::get().applyNotConverged[i]));
+    }
+    return ret;
+}
+
+std::map<std::string, uint64_t> Diagnostics::objectCounts() const
+{
+    return stats::get().objectSnapshot();
+}
+
+uint64_t Diagnostics::heapBytes() const
+{
+    return stats::heapBytes();
+}
+
+uint64_t Diagnostics::residentBytes() const
+{
+    return stats::residentBytes();
+}
+
+} // namespace network
+} // namespace phosphor
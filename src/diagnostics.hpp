@@ -0,0 +1,87 @@
+#pragma once
+#include "startup.hpp"
+#include "xyz/openbmc_project/Network/Diagnostics/ApplyLatency/server.hpp"
+#include "xyz/openbmc_project/Network/Diagnostics/Memory/server.hpp"
+#include "xyz/openbmc_project/Network/Diagnostics/Stalls/server.hpp"
+#include "xyz/openbmc_project/Network/Diagnostics/Startup/server.hpp"
+#include "xyz/openbmc_project/Network/Diagnostics/Statistics/server.hpp"
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/server/object.hpp>
+#include <stdplus/zstring.hpp>
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace phosphor
+{
+namespace network
+{
+
+using StartupIntf =
+    sdbusplus::xyz::openbmc_project::Network::Diagnostics::server::Startup;
+
+using StatisticsIntf =
+    sdbusplus::xyz::openbmc_project::Network::Diagnostics::server::Statistics;
+
+using ApplyLatencyIntf =
+    sdbusplus::xyz::openbmc_project::Network::Diagnostics::server::ApplyLatency;
+
+using StallsIntf =
+    sdbusplus::xyz::openbmc_project::Network::Diagnostics::server::Stalls;
+
+using MemoryIntf =
+    sdbusplus::xyz::openbmc_project::Network::Diagnostics::server::Memory;
+
+using DiagnosticsIfaces =
+    sdbusplus::server::object_t<StartupIntf, StatisticsIntf, ApplyLatencyIntf,
+                                StallsIntf, MemoryIntf>;
+
+/** @class Diagnostics
+ *  @brief Exposes the internal timings of the network manager on D-Bus.
+ */
+class Diagnostics : public DiagnosticsIfaces
+{
+  public:
+    Diagnostics(Diagnostics&&) = delete;
+    Diagnostics& operator=(Diagnostics&&) = delete;
+
+    /** @brief Constructor to put object onto bus at a dbus path.
+     *  @param[in] bus - Bus to attach to.
+     *  @param[in] objPath - Path to attach at.
+     */
+    Diagnostics(sdbusplus::bus_t& bus, stdplus::const_zstring objPath);
+
+    /** @brief Publishes the phase timings of a completed startup */
+    void startupComplete(const Startup& startup);
+
+    /** @brief The statistics are sampled from the process wide counters
+     *         whenever they are read
+     */
+    std::map<std::string, uint64_t> netlinkMessages() const override;
+    uint64_t netlinkParseErrors() const override;
+    uint64_t ignoredInterfaceEvents() const override;
+    uint64_t configFilesWritten() const override;
+    uint64_t configFilesSkipped() const override;
+    uint64_t configBytesWritten() const override;
+    uint64_t reloads() const override;
+    std::vector<uint64_t> reloadLatency() const override;
+    uint64_t signalsEmitted() const override;
+    uint64_t methodCalls() const override;
+    std::vector<uint64_t> methodCallLatency() const override;
+    std::map<std::string, std::vector<uint64_t>> latency() const override;
+    std::map<std::string, uint64_t> notConverged() const override;
+    uint64_t budget() const override;
+    uint64_t budget(uint64_t value) override;
+    uint64_t count() const override;
+    std::vector<std::tuple<std::string, uint64_t>> slowest() const override;
+    std::map<std::string, uint64_t> objectCounts() const override;
+    uint64_t heapBytes() const override;
+    uint64_t residentBytes() const override;
+};
+
+} // namespace network
+} // namespace phosphor
@@ -5,6 +5,7 @@
 #include "config_parser.hpp"
 #include "network_manager.hpp"
 #include "system_queries.hpp"
+#include "tracepoints.hpp"
 #include "util.hpp"
 
 #include <linux/rtnetlink.h>
@@ -15,16 +16,18 @@
 #include <phosphor-logging/elog-errors.hpp>
 #include <phosphor-logging/lg2.hpp>
 #include <stdplus/fd/create.hpp>
-#include <stdplus/raw.hpp>
+#include <stdplus/numeric/str.hpp>
 #include <stdplus/str/cat.hpp>
 #include <stdplus/zstring.hpp>
 #include <xyz/openbmc_project/Common/error.hpp>
 
 #include <algorithm>
+#include <cerrno>
+#include <cstring>
 #include <filesystem>
-#include <format>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <variant>
 
 namespace phosphor
@@ -38,20 +41,10 @@ using NotAllowed = sdbusplus::xyz::openbmc_project::Common::Error::NotAllowed;
 using NotAllowedArgument = xyz::openbmc_project::Common::NotAllowed;
 using Argument = xyz::openbmc_project::Common::InvalidArgument;
 using std::literals::string_view_literals::operator""sv;
-constexpr auto RESOLVED_SERVICE = "org.freedesktop.resolve1";
-constexpr auto RESOLVED_INTERFACE = "org.freedesktop.resolve1.Link";
-constexpr auto PROPERTY_INTERFACE = "org.freedesktop.DBus.Properties";
-constexpr auto RESOLVED_SERVICE_PATH = "/org/freedesktop/resolve1/link/";
-
-constexpr auto TIMESYNCD_SERVICE = "org.freedesktop.timesync1";
-constexpr auto TIMESYNCD_INTERFACE = "org.freedesktop.timesync1.Manager";
-constexpr auto TIMESYNCD_SERVICE_PATH = "/org/freedesktop/timesync1";
-
-constexpr auto METHOD_GET = "Get";
 
 template <typename Func>
 inline decltype(std::declval<Func>()())
-    ignoreError(std::string_view msg, stdplus::zstring_view intf,
+    ignoreError(std::string_view msg, std::string_view intf,
                 decltype(std::declval<Func>()()) fallback, Func&& func) noexcept
 {
     try
@@ -79,6 +72,126 @@ static bool validIntfIP(Addr a) noexcept
     return a.isUnicast() && !a.isLoopback();
 }
 
+/** @brief Whether all of the bits past the prefix are clear */
+static bool isNetwork(stdplus::InAnyAddr addr, uint8_t pfx) noexcept
+{
+    return std::visit(
+        [&](const auto& a) {
+            auto bytes = reinterpret_cast<const uint8_t*>(&a);
+            for (size_t i = 0; i < sizeof(a); ++i, pfx = pfx > 8 ? pfx - 8 : 0)
+            {
+                auto mask = pfx >= 8 ? 0xff
+                                     : static_cast<uint8_t>(0xff00 >> pfx);
+                if ((bytes[i] & ~mask) != 0)
+                {
+                    return false;
+                }
+            }
+            return true;
+        },
+        addr);
+}
+
+/** @brief Validates a static route as given over D-Bus */
+static auto parseRoute(const std::string& destination, uint8_t prefixLength,
+                       const std::string& gateway, uint32_t metric)
+{
+    std::optional<stdplus::InAnyAddr> addr;
+    try
+    {
+        addr.emplace(stdplus::fromStr<stdplus::InAnyAddr>(destination));
+    }
+    catch (const std::exception& e)
+    {
+        lg2::error("Invalid route destination {NET_IP}: {ERROR}", "NET_IP",
+                   destination, "ERROR", e);
+        elog<InvalidArgument>(Argument::ARGUMENT_NAME("Destination"),
+                              Argument::ARGUMENT_VALUE(destination.c_str()));
+    }
+    uint8_t bits = std::holds_alternative<stdplus::In4Addr>(*addr) ? 32 : 128;
+    if (prefixLength == 0 || prefixLength > bits ||
+        !isNetwork(*addr, prefixLength))
+    {
+        lg2::error("Invalid route prefix length {NET_PFX} for {NET_IP}",
+                   "NET_PFX", prefixLength, "NET_IP", destination);
+        elog<InvalidArgument>(
+            Argument::ARGUMENT_NAME("PrefixLength"),
+            Argument::ARGUMENT_VALUE(stdplus::toStr(prefixLength).c_str()));
+    }
+    std::optional<stdplus::InAnyAddr> gw;
+    if (!gateway.empty())
+    {
+        try
+        {
+            gw.emplace(stdplus::fromStr<stdplus::InAnyAddr>(gateway));
+            if (gw->index() != addr->index())
+            {
+                throw std::invalid_argument("family mismatch");
+            }
+            if (!std::visit([](auto ip) { return validIntfIP(ip); }, *gw))
+            {
+                throw std::invalid_argument("not unicast");
+            }
+        }
+        catch (const std::exception& e)
+        {
+            lg2::error("Invalid route gateway {NET_GW}: {ERROR}", "NET_GW",
+                       gateway, "ERROR", e);
+            elog<InvalidArgument>(Argument::ARGUMENT_NAME("Gateway"),
+                                  Argument::ARGUMENT_VALUE(gateway.c_str()));
+        }
+    }
+    return std::make_tuple(stdplus::SubnetAny{*addr, prefixLength}, gw,
+                           metric);
+}
+
+/** @brief The static routes of the config. The sections without a
+ *         destination are the default gateways.
+ */
+static auto configRoutes(const config::Parser& config)
+{
+    std::vector<decltype(parseRoute({}, 0, {}, 0))> ret;
+    auto sit = config.map.find("Route");
+    if (sit == config.map.end())
+    {
+        return ret;
+    }
+    for (const auto& section : sit->second)
+    {
+        auto dit = section.find("Destination");
+        if (dit == section.end() || dit->second.empty())
+        {
+            continue;
+        }
+        try
+        {
+            auto dst = stdplus::fromStr<stdplus::SubnetAny>(
+                dit->second.back().get());
+            std::optional<stdplus::InAnyAddr> gw;
+            if (auto git = section.find("Gateway");
+                git != section.end() && !git->second.empty())
+            {
+                gw.emplace(stdplus::fromStr<stdplus::InAnyAddr>(
+                    git->second.back().get()));
+            }
+            uint32_t metric = 0;
+            if (auto mit = section.find("Metric");
+                mit != section.end() && !mit->second.empty())
+            {
+                metric = stdplus::StrToInt<10, uint32_t>{}(
+                    mit->second.back().get());
+            }
+            ret.emplace_back(dst, gw, metric);
+        }
+        catch (const std::exception& e)
+        {
+            lg2::error("Invalid route in {CFG_FILE}: {ERROR}", "CFG_FILE",
+                       config.getFilename(), "ERROR", e);
+        }
+    }
+    return ret;
+}
+
 EthernetInterface::EthernetInterface(
     stdplus::PinnedRef<sdbusplus::bus_t> bus,
     stdplus::PinnedRef<Manager> manager, const AllIntfInfo& info,
@@ -94,7 +207,7 @@ EthernetInterface::EthernetInterface(
     Ifaces(bus, objPath.c_str(), Ifaces::action::defer_emit), manager(manager),
     bus(bus), objPath(std::move(objPath))
 {
-    interfaceName(*info.intf.name, true);
+    interfaceName(std::string(*info.intf.name), true);
     auto dhcpVal = getDHCPValue(config);
     EthernetInterfaceIntf::dhcp4(dhcpVal.v4, true);
     EthernetInterfaceIntf::dhcp6(dhcpVal.v6, true);
@@ -116,16 +229,7 @@ EthernetInterface::EthernetInterface(
     }
     emit_object_added();
 
-    if (info.intf.vlan_id)
-    {
-        if (!info.intf.parent_idx)
-        {
-            std::runtime_error("Missing parent link");
-        }
-        vlan.emplace(bus, this->objPath.c_str(), info.intf, *this);
-    }
-    dhcp4Conf.emplace(bus, this->objPath + "/dhcp4", *this, DHCPType::v4);
-    dhcp6Conf.emplace(bus, this->objPath + "/dhcp6", *this, DHCPType::v6);
+    addConfigured(info.intf, config);
     for (const auto& [_, addr] : info.addrs)
     {
         addAddr(addr);
@@ -136,13 +240,108 @@ EthernetInterface::EthernetInterface(
     }
 }
 
+EthernetInterface::EthernetInterface(stdplus::PinnedRef<sdbusplus::bus_t> bus,
+                                     const InterfaceInfo& info,
+                                     std::string_view objRoot,
+                                     const config::Parser& config,
+                                     const EthernetInterface& old) :
+    EthernetInterface(bus, info, makeObjPath(objRoot, *info.name), config, old)
+{}
+
+EthernetInterface::EthernetInterface(stdplus::PinnedRef<sdbusplus::bus_t> bus,
+                                     const InterfaceInfo& info,
+                                     std::string&& objPath,
+                                     const config::Parser& config,
+                                     const EthernetInterface& old) :
+    Ifaces(bus, objPath.c_str(), Ifaces::action::defer_emit),
+    manager(old.manager), bus(bus), objPath(std::move(objPath))
+{
+    interfaceName(std::string(*info.name), true);
+    auto dhcpVal = getDHCPValue(config);
+    EthernetInterfaceIntf::dhcp4(dhcpVal.v4, true);
+    EthernetInterfaceIntf::dhcp6(dhcpVal.v6, true);
+    EthernetInterfaceIntf::ipv6AcceptRA(getIPv6AcceptRA(config), true);
+    EthernetInterfaceIntf::nicEnabled(old.nicEnabled(), true);
+
+    // The mirrors of resolved and timesyncd are keyed by the link index,
+    // so the servers they reported still hold
+    EthernetInterfaceIntf::ntpServers(old.EthernetInterfaceIntf::ntpServers(),
+                                      true);
+    EthernetInterfaceIntf::staticNTPServers(
+        config.map.getValueStrings("Network", "NTP"), true);
+    EthernetInterfaceIntf::nameservers(
+        old.EthernetInterfaceIntf::nameservers(), true);
+    EthernetInterfaceIntf::staticNameServers(
+        config.map.getValueStrings("Network", "DNS"), true);
+
+    MacAddressIntf::macAddress(old.macAddress(), true);
+    EthernetInterfaceIntf::defaultGateway(old.defaultGateway(), true);
+    EthernetInterfaceIntf::defaultGateway6(old.defaultGateway6(), true);
+    updateInfo(info, true);
+    emit_object_added();
+
+    addConfigured(info, config);
+    for (const auto& [ifaddr, addr] : old.addrs)
+    {
+        addrs.emplace(ifaddr, std::make_unique<IPAddress>(
+                                  bus, std::string_view(this->objPath), *this,
+                                  ifaddr, addr->origin()));
+    }
+    for (const auto& [ip, neigh] : old.staticNeighbors)
+    {
+        staticNeighbors.emplace(
+            ip, std::make_unique<Neighbor>(
+                    bus, std::string_view(this->objPath), *this, ip,
+                    stdplus::fromStr<stdplus::EtherAddr>(neigh->macAddress()),
+                    Neighbor::State::Permanent));
+    }
+
+    // The kernel keeps the routes of the link, the ones the config of the
+    // new name does not list included
+    for (const auto& [dst, route] : old.staticRoutes)
+    {
+        if (!staticRoutes.contains(dst))
+        {
+            staticRoutes.emplace(dst, std::make_unique<StaticRoute>(
+                                          bus, std::string_view(this->objPath),
+                                          *this, dst, route->getGateway(),
+                                          route->metric()));
+        }
+    }
+}
+
+void EthernetInterface::addConfigured(const InterfaceInfo& info,
+                                      const config::Parser& config)
+{
+    if (info.vlan_id)
+    {
+        if (!info.parent_idx)
+        {
+            std::runtime_error("Missing parent link");
+        }
+        vlan.emplace(bus, objPath.c_str(), info, *this);
+    }
+    dhcp4Conf.emplace(bus, objPath + "/dhcp4", *this, DHCPType::v4, config);
+    dhcp6Conf.emplace(bus, objPath + "/dhcp6", *this, DHCPType::v6, config);
+    for (const auto& [dst, gw, metric] : configRoutes(config))
+    {
+        staticRoutes.emplace(dst, std::make_unique<StaticRoute>(
+                                      bus, std::string_view(objPath), *this,
+                                      dst, gw, metric));
+    }
+}
+
 void EthernetInterface::updateInfo(const InterfaceInfo& info, bool skipSignal)
 {
     ifIdx = info.idx;
     EthernetInterfaceIntf::linkUp(info.flags & IFF_RUNNING, skipSignal);
     if (info.mac)
     {
-        MacAddressIntf::macAddress(stdplus::toStr(*info.mac), skipSignal);
+        stdplus::ToStrHandle<stdplus::ToStr<stdplus::EtherAddr>> tsh;
+        if (auto mac = tsh(*info.mac); MacAddressIntf::macAddress() != mac)
+        {
+            MacAddressIntf::macAddress(std::string(mac), skipSignal);
+        }
     }
     if (info.mtu)
     {
@@ -278,6 +477,8 @@ ObjectPath EthernetInterface::ip(IP::Protocol protType, std::string ipaddress,
             *ifaddr,
             std::make_unique<IPAddress>(bus, std::string_view(objPath), *this,
                                         *ifaddr, IP::AddressOrigin::Static)));
+        manager.get().getApplyTracker().expect(stats::ApplyOp::Address, ifIdx,
+                                               *ifaddr);
     }
     else
     {
@@ -297,54 +498,229 @@ ObjectPath EthernetInterface::ip(IP::Protocol protType, std::string ipaddress,
 ObjectPath EthernetInterface::neighbor(std::string ipAddress,
                                        std::string macAddress)
 {
-    std::optional<stdplus::InAnyAddr> addr;
-    try
+    return neighbors({{std::move(ipAddress), std::move(macAddress)}}).front();
+}
+
+std::vector<ObjectPath> EthernetInterface::neighbors(
+    std::vector<std::tuple<std::string, std::string>> neighbors)
+{
+    // Validate the whole batch before changing anything
+    std::vector<std::pair<stdplus::InAnyAddr, stdplus::EtherAddr>> parsed;
+    parsed.reserve(neighbors.size());
+    std::unordered_set<stdplus::InAnyAddr> seen;
+    for (const auto& [ipAddress, macAddress] : neighbors)
     {
-        addr.emplace(stdplus::fromStr<stdplus::InAnyAddr>(ipAddress));
+        std::optional<stdplus::InAnyAddr> addr;
+        try
+        {
+            addr.emplace(stdplus::fromStr<stdplus::InAnyAddr>(ipAddress));
+        }
+        catch (const std::exception& e)
+        {
+            lg2::error("Not a valid IP address {NET_IP}: {ERROR}", "NET_IP",
+                       ipAddress, "ERROR", e);
+            elog<InvalidArgument>(Argument::ARGUMENT_NAME("ipAddress"),
+                                  Argument::ARGUMENT_VALUE(ipAddress.c_str()));
+        }
+        if (!seen.emplace(*addr).second)
+        {
+            lg2::error("Duplicate neighbor {NET_IP}", "NET_IP", ipAddress);
+            elog<InvalidArgument>(Argument::ARGUMENT_NAME("ipAddress"),
+                                  Argument::ARGUMENT_VALUE(ipAddress.c_str()));
+        }
+
+        std::optional<stdplus::EtherAddr> lladdr;
+        try
+        {
+            lladdr.emplace(stdplus::fromStr<stdplus::EtherAddr>(macAddress));
+        }
+        catch (const std::exception& e)
+        {
+            lg2::error("Not a valid MAC address {NET_MAC}: {ERROR}", "NET_MAC",
+                       macAddress, "ERROR", e);
+            elog<InvalidArgument>(
+                Argument::ARGUMENT_NAME("macAddress"),
+                Argument::ARGUMENT_VALUE(macAddress.c_str()));
+        }
+        parsed.emplace_back(*addr, *lladdr);
     }
-    catch (const std::exception& e)
+
+    std::vector<ObjectPath> ret;
+    ret.reserve(parsed.size());
+    bool changed = false;
+    for (const auto& [addr, lladdr] : parsed)
     {
-        lg2::error("Not a valid IP address {NET_IP}: {ERROR}", "NET_IP",
-                   ipAddress, "ERROR", e);
-        elog<InvalidArgument>(Argument::ARGUMENT_NAME("ipAddress"),
-                              Argument::ARGUMENT_VALUE(ipAddress.c_str()));
+        auto it = staticNeighbors.find(addr);
+        if (it == staticNeighbors.end())
+        {
+            it = std::get<0>(staticNeighbors.emplace(
+                addr, std::make_unique<Neighbor>(
+                          bus, std::string_view(objPath), *this, addr, lladdr,
+                          Neighbor::State::Permanent)));
+            changed = true;
+        }
+        else if (auto str = stdplus::toStr(lladdr);
+                 it->second->macAddress() != str)
+        {
+            it->second->NeighborObj::macAddress(str);
+            changed = true;
+        }
+        ret.push_back(it->second->getObjPath());
     }
 
-    std::optional<stdplus::EtherAddr> lladdr;
-    try
+    if (changed)
     {
-        lladdr.emplace(stdplus::fromStr<stdplus::EtherAddr>(macAddress));
+        writeConfigurationFile();
+        manager.get().reloadConfigs();
     }
-    catch (const std::exception& e)
+
+    return ret;
+}
+
+std::vector<std::tuple<std::string, std::string>>
+    EthernetInterface::exportNeighbors()
+{
+    std::vector<std::tuple<std::string, std::string>> ret;
+    ret.reserve(staticNeighbors.size());
+    for (const auto& [_, neighbor] : staticNeighbors)
     {
-        lg2::error("Not a valid MAC address {NET_MAC}: {ERROR}", "NET_MAC",
-                   macAddress, "ERROR", e);
-        elog<InvalidArgument>(Argument::ARGUMENT_NAME("macAddress"),
-                              Argument::ARGUMENT_VALUE(macAddress.c_str()));
+        ret.emplace_back(neighbor->ipAddress(), neighbor->macAddress());
+    }
+    std::sort(ret.begin(), ret.end());
+    return ret;
+}
+
+ObjectPath EthernetInterface::route(std::string destination,
+                                   uint8_t prefixLength, std::string gateway,
+                                   uint32_t metric)
+{
+    auto spec = parseRoute(destination, prefixLength, gateway, metric);
+    return updateRoutes({&spec, 1}, false).front();
+}
+
+std::vector<ObjectPath> EthernetInterface::setRoutes(
+    std::vector<std::tuple<std::string, uint8_t, std::string, uint32_t>>
+        routes)
+{
+    // Validate the whole batch before changing anything
+    std::vector<RouteSpec> parsed;
+    parsed.reserve(routes.size());
+    std::unordered_set<stdplus::SubnetAny> seen;
+    for (const auto& [destination, prefixLength, gateway, metric] : routes)
+    {
+        const auto& spec = parsed.emplace_back(
+            parseRoute(destination, prefixLength, gateway, metric));
+        if (!seen.emplace(std::get<0>(spec)).second)
+        {
+            lg2::error("Duplicate route {NET_IP}", "NET_IP", destination);
+            elog<InvalidArgument>(
+                Argument::ARGUMENT_NAME("Destination"),
+                Argument::ARGUMENT_VALUE(destination.c_str()));
+        }
     }
+    return updateRoutes(parsed, true);
+}
 
-    auto it = staticNeighbors.find(*addr);
-    if (it == staticNeighbors.end())
+std::vector<ObjectPath>
+    EthernetInterface::updateRoutes(std::span<const RouteSpec> routes,
+                                    bool exclusive)
+{
+    std::vector<RouteInfo> del, add;
+    if (exclusive)
     {
-        it = std::get<0>(staticNeighbors.emplace(
-            *addr, std::make_unique<Neighbor>(bus, std::string_view(objPath),
-                                              *this, *addr, *lladdr,
-                                              Neighbor::State::Permanent)));
+        std::unordered_set<stdplus::SubnetAny> keep;
+        for (const auto& spec : routes)
+        {
+            keep.emplace(std::get<0>(spec));
+        }
+        for (auto it = staticRoutes.begin(); it != staticRoutes.end();)
+        {
+            if (keep.contains(it->first))
+            {
+                ++it;
+                continue;
+            }
+            del.push_back(it->second->routeInfo(ifIdx));
+            it = staticRoutes.erase(it);
+        }
     }
-    else
+
+    std::vector<ObjectPath> ret;
+    ret.reserve(routes.size());
+    for (const auto& [dst, gw, metric] : routes)
     {
-        auto str = stdplus::toStr(*lladdr);
-        if (it->second->macAddress() == str)
+        auto it = staticRoutes.find(dst);
+        if (it == staticRoutes.end())
         {
-            return it->second->getObjPath();
+            it = std::get<0>(staticRoutes.emplace(
+                dst, std::make_unique<StaticRoute>(
+                         bus, std::string_view(objPath), *this, dst, gw,
+                         metric)));
+            add.push_back(it->second->routeInfo(ifIdx));
+        }
+        else if (it->second->getGateway() != gw ||
+                 it->second->metric() != metric)
+        {
+            // The kernel only replaces the route of the same metric
+            if (it->second->metric() != metric)
+            {
+                del.push_back(it->second->routeInfo(ifIdx));
+            }
+            it->second->update(gw, metric);
+            add.push_back(it->second->routeInfo(ifIdx));
         }
-        it->second->NeighborObj::macAddress(str);
+        ret.push_back(it->second->getObjPath());
     }
 
+    if (!del.empty() || !add.empty())
+    {
+        applyRoutes(del, add);
+    }
+    return ret;
+}
+
+void EthernetInterface::applyRoutes(std::span<const RouteInfo> del,
+                                    std::span<const RouteInfo> add)
+{
     writeConfigurationFile();
+    if (ifIdx == 0)
+    {
+        // networkd programs them once the link shows up
+        manager.get().reloadConfigs();
+        return;
+    }
+    try
+    {
+        auto errs = system::changeRoutes(del, add);
+        bool failed = false;
+        for (size_t i = 0; i < errs.size(); ++i)
+        {
+            bool isDel = i < del.size();
+            // Deleting a route that is already gone is fine
+            if (errs[i] == 0 || (isDel && errs[i] == ESRCH))
+            {
+                continue;
+            }
+            const auto& route = isDel ? del[i] : add[i - del.size()];
+            lg2::error("Failed to {OP} route {NET_ROUTE} on {NET_INTF}: "
+                       "{ERROR}",
+                       "OP", isDel ? "delete" : "add", "NET_ROUTE",
+                       stdplus::toStr(route.dst), "NET_INTF", interfaceName(),
+                       "ERROR", std::strerror(errs[i]));
+            failed = true;
+        }
+        if (!failed)
+        {
+            return;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        lg2::error("Failed to program routes on {NET_INTF}: {ERROR}",
+                   "NET_INTF", interfaceName(), "ERROR", e);
+    }
+    // Leave it to networkd to converge on the config
     manager.get().reloadConfigs();
-
-    return it->second->getObjPath();
 }
 
 bool EthernetInterface::ipv6AcceptRA(bool value)
@@ -488,28 +864,7 @@ void EthernetInterface::loadNameServers(const config::Parser& config)
 
 ServerList EthernetInterface::getNTPServerFromTimeSyncd()
 {
-    ServerList servers; // Variable to capture the NTP Server IPs
-    auto method =
-        bus.get().new_method_call(TIMESYNCD_SERVICE, TIMESYNCD_SERVICE_PATH,
-                                  PROPERTY_INTERFACE, METHOD_GET);
-
-    method.append(TIMESYNCD_INTERFACE, "LinkNTPServers");
-
-    try
-    {
-        auto reply = bus.get().call(method);
-        std::variant<ServerList> response;
-        reply.read(response);
-        servers = std::get<ServerList>(response);
-    }
-    catch (const sdbusplus::exception::SdBusError& e)
-    {
-        lg2::error("Failed to get NTP server information from "
-                   "systemd-timesyncd: {ERROR}",
-                   "ERROR", e);
-    }
-
-    return servers;
+    return manager.get().getServiceMirror().getNTP();
 }
 
 ServerList EthernetInterface::nameservers() const
@@ -519,64 +874,40 @@ ServerList EthernetInterface::nameservers() const
 
 ServerList EthernetInterface::getNameServerFromResolvd() const
 {
-    ServerList servers;
-    auto OBJ_PATH = std::format("{}{}", RESOLVED_SERVICE_PATH, ifIdx);
-
-    /*
-      The DNS property under org.freedesktop.resolve1.Link interface contains
-      an array containing all DNS servers currently used by resolved. It
-      contains similar information as the DNS server data written to
-      /run/systemd/resolve/resolv.conf.
-
-      Each structure in the array consists of a numeric network interface index,
-      an address family, and a byte array containing the DNS server address
-      (either 4 bytes in length for IPv4 or 16 bytes in lengths for IPv6).
-      The array contains DNS servers configured system-wide, including those
-      possibly read from a foreign /etc/resolv.conf or the DNS= setting in
-      /etc/systemd/resolved.conf, as well as per-interface DNS server
-      information either retrieved from systemd-networkd or configured by
-      external software via SetLinkDNS().
-    */
-
-    using type = std::vector<std::tuple<int32_t, std::vector<uint8_t>>>;
-    std::variant<type> name; // Variable to capture the DNS property
-    auto method = bus.get().new_method_call(RESOLVED_SERVICE, OBJ_PATH.c_str(),
-                                            PROPERTY_INTERFACE, METHOD_GET);
-
-    method.append(RESOLVED_INTERFACE, "DNS");
-
-    try
-    {
-        auto reply = bus.get().call(method);
-        reply.read(name);
-    }
-    catch (const sdbusplus::exception_t& e)
-    {
-        lg2::error(
-            "Failed to get DNS information from systemd-resolved: {ERROR}",
-            "ERROR", e);
-    }
-    auto tupleVector = std::get_if<type>(&name);
-    for (auto i = tupleVector->begin(); i != tupleVector->end(); ++i)
-    {
-        int addressFamily = std::get<0>(*i);
-        std::vector<uint8_t>& ipaddress = std::get<1>(*i);
-        servers.push_back(stdplus::toStr(
-            addrFromBuf(addressFamily, stdplus::raw::asView<char>(ipaddress))));
-    }
-    return servers;
+    return manager.get().getServiceMirror().getDNS(ifIdx);
 }
 
 ObjectPath EthernetInterface::createVLAN(uint16_t id)
 {
-    auto idStr = stdplus::toStr(id);
-    auto intfName = stdplus::strCat(interfaceName(), "."sv, idStr);
-    if (manager.get().interfaces.find(intfName) !=
-        manager.get().interfaces.end())
-    {
-        lg2::error("VLAN {NET_VLAN} already exists", "NET_VLAN", id);
-        elog<InvalidArgument>(Argument::ARGUMENT_NAME("VLANId"),
-                              Argument::ARGUMENT_VALUE(idStr.c_str()));
+    return createVLANs(std::span(&id, 1)).front();
+}
+
+std::vector<ObjectPath>
+    EthernetInterface::createVLANs(std::span<const uint16_t> ids)
+{
+    // Validate the whole batch before creating anything
+    std::vector<std::string> intfNames;
+    intfNames.reserve(ids.size());
+    std::unordered_set<uint16_t> seen;
+    for (auto id : ids)
+    {
+        auto idStr = stdplus::toStr(id);
+        auto intfName = stdplus::strCat(interfaceName(), "."sv, idStr);
+        if (intfName.size() > IfName::capacity())
+        {
+            lg2::error("VLAN name {NET_INTF} is too long", "NET_INTF",
+                       intfName);
+            elog<InvalidArgument>(Argument::ARGUMENT_NAME("VLANId"),
+                                  Argument::ARGUMENT_VALUE(idStr.c_str()));
+        }
+        if (manager.get().interfaces.contains(intfName) ||
+            !seen.emplace(id).second)
+        {
+            lg2::error("VLAN {NET_VLAN} already exists", "NET_VLAN", id);
+            elog<InvalidArgument>(Argument::ARGUMENT_NAME("VLANId"),
+                                  Argument::ARGUMENT_VALUE(idStr.c_str()));
+        }
+        intfNames.push_back(std::move(intfName));
     }
 
     auto objRoot = std::string_view(objPath).substr(0, objPath.rfind('/'));
@@ -586,33 +917,84 @@ ObjectPath EthernetInterface::createVLAN(uint16_t id)
     {
         mac.emplace(stdplus::fromStr<stdplus::EtherAddr>(macStr));
     }
-    auto info = AllIntfInfo{InterfaceInfo{
-        .type = ARPHRD_ETHER,
-        .idx = 0, // TODO: Query the correct value after creation
-        .flags = 0,
-        .name = intfName,
-        .mac = std::move(mac),
-        .mtu = mtu(),
-        .parent_idx = ifIdx,
-        .vlan_id = id,
-    }};
-
-    // Pass the parents nicEnabled property, so that the child
-    // VLAN interface can inherit.
-    auto vlanIntf = std::make_unique<EthernetInterface>(
-        bus, manager, info, objRoot, config::Parser(), nicEnabled());
-    ObjectPath ret = vlanIntf->objPath;
-
-    manager.get().interfaces.emplace(intfName, std::move(vlanIntf));
-
-    // write the device file for the vlan interface.
-    config::Parser config;
-    auto& netdev = config.map["NetDev"].emplace_back();
-    netdev["Name"].emplace_back(intfName);
-    netdev["Kind"].emplace_back("vlan");
-    config.map["VLAN"].emplace_back()["Id"].emplace_back(std::move(idStr));
-    config.writeFile(
-        config::pathForIntfDev(manager.get().getConfDir(), intfName));
+
+    // Create the links up front so the objects know their index right
+    // away, undoing the ones already made if any of them fails
+    std::vector<InterfaceInfo> links;
+    if (manager.get().directVlan)
+    {
+        links.reserve(ids.size());
+        try
+        {
+            for (size_t i = 0; i < ids.size(); ++i)
+            {
+                links.push_back(
+                    system::createVLAN(ifIdx, intfNames[i], ids[i]));
+            }
+        }
+        catch (const std::exception& e)
+        {
+            lg2::error("Failed to create VLAN link: {ERROR}", "ERROR", e);
+            for (const auto& link : links)
+            {
+                try
+                {
+                    system::deleteIntf(link.idx);
+                }
+                catch (const std::exception& err)
+                {
+                    lg2::error("Failed to delete VLAN link: {ERROR}", "ERROR",
+                               err);
+                }
+            }
+            elog<InternalFailure>();
+        }
+    }
+
+    std::vector<ObjectPath> ret;
+    ret.reserve(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+        const auto& intfName = intfNames[i];
+        auto info = AllIntfInfo{InterfaceInfo{
+            .type = ARPHRD_ETHER,
+            .idx = 0, // Assigned once networkd creates it
+            .flags = 0,
+            .name = intfName,
+            .mac = mac,
+            .mtu = mtu(),
+            .parent_idx = ifIdx,
+            .vlan_id = ids[i],
+        }};
+        if (!links.empty())
+        {
+            info.intf = links[i];
+        }
+
+        // Pass the parents nicEnabled property, so that the child
+        // VLAN interface can inherit.
+        auto vlanIntf = std::make_unique<EthernetInterface>(
+            bus, manager, info, objRoot, config::Parser(), nicEnabled());
+        ret.push_back(vlanIntf->objPath);
+        if (auto idx = info.intf.idx; idx > 0)
+        {
+            manager.get().links.insert_or_assign(
+                idx, Manager::Link{.info = std::move(info),
+                                   .intf = vlanIntf.get()});
+        }
+
+        manager.get().interfaces.emplace(intfName, std::move(vlanIntf));
+
+        // write the device file for the vlan interface.
+        config::Parser config;
+        auto& netdev = config.map["NetDev"].emplace_back();
+        netdev["Name"].emplace_back(intfName);
+        netdev["Kind"].emplace_back("vlan");
+        config.map["VLAN"].emplace_back()["Id"].emplace_back(
+            stdplus::toStr(ids[i]));
+        config.writeFile(
+            config::pathForIntfDev(manager.get().getConfDir(), intfName));
+    }
 
     writeConfigurationFile();
     manager.get().reloadConfigs();
@@ -620,6 +1002,39 @@ ObjectPath EthernetInterface::createVLAN(uint16_t id)
     return ret;
 }
 
+void EthernetInterface::deleteVLANs(std::span<const uint16_t> ids)
+{
+    // Resolve the whole batch before deleting anything
+    std::vector<EthernetInterface*> vlans;
+    vlans.reserve(ids.size());
+    std::unordered_set<uint16_t> seen;
+    for (auto id : ids)
+    {
+        auto intfName = stdplus::strCat(interfaceName(), "."sv,
+                                        stdplus::toStr(id));
+        auto it = manager.get().interfaces.find(intfName);
+        if (it == manager.get().interfaces.end() || !it->second->vlan ||
+            it->second->vlan->parentIdx != ifIdx || !seen.emplace(id).second)
+        {
+            using ResourceErr = phosphor::logging::xyz::openbmc_project::
+                Common::ResourceNotFound;
+            elog<ResourceNotFound>(ResourceErr::RESOURCE(intfName.c_str()));
+        }
+        vlans.push_back(it->second.get());
+    }
+
+    std::vector<std::unique_ptr<EthernetInterface>> objs;
+    objs.reserve(vlans.size());
+    for (auto vlanIntf : vlans)
+    {
+        objs.push_back(vlanIntf->vlan->detach());
+    }
+
+    // Write an updated config since it no longer has the VLAN entries
+    writeConfigurationFile();
+    manager.get().reloadConfigs();
+}
+
 ServerList EthernetInterface::staticNTPServers(ServerList value)
 {
     value = EthernetInterfaceIntf::staticNTPServers(std::move(value));
@@ -673,6 +1088,7 @@ static void writeUpdatedTime(const Manager& manager,
 
 void EthernetInterface::writeConfigurationFile()
 {
+    NETWORKD_TRACE(write_config, ifIdx);
     config::Parser config;
     config.map["Match"].emplace_back()["Name"].emplace_back(interfaceName());
     {
@@ -702,12 +1118,17 @@ void EthernetInterface::writeConfigurationFile()
                                              : (dhcp6() ? "ipv6" : "false"));
         {
             auto& vlans = network["VLAN"];
-            for (const auto& [_, intf] : manager.get().interfaces)
+            const auto& children = manager.get().vlanChildren;
+            if (auto it = children.find(ifIdx); it != children.end())
             {
-                if (intf->vlan && intf->vlan->parentIdx == ifIdx)
+                for (auto intf : it->second)
                 {
                     vlans.emplace_back(intf->interfaceName());
                 }
+                std::sort(vlans.begin(), vlans.end(),
+                          [](const auto& a, const auto& b) {
+                              return a.get() < b.get();
+                          });
             }
         }
         {
@@ -758,6 +1179,29 @@ void EthernetInterface::writeConfigurationFile()
             }
         }
     }
+    {
+        // Sorted so that the same routes always give the same file
+        std::vector<std::pair<std::string, const StaticRoute*>> routes;
+        routes.reserve(staticRoutes.size());
+        for (const auto& [dst, route] : staticRoutes)
+        {
+            routes.emplace_back(stdplus::toStr(dst), route.get());
+        }
+        std::sort(routes.begin(), routes.end());
+        for (const auto& [dst, sroute] : routes)
+        {
+            auto& route = config.map["Route"].emplace_back();
+            route["Destination"].emplace_back(dst);
+            if (auto gw = sroute->gateway(); !gw.empty())
+            {
+                route["Gateway"].emplace_back(std::move(gw));
+            }
+            if (auto metric = sroute->metric(); metric != 0)
+            {
+                route["Metric"].emplace_back(stdplus::toStr(metric));
+            }
+        }
+    }
     config.map["IPv6AcceptRA"].emplace_back()["DHCPv6Client"].emplace_back(
         dhcp6() ? "true" : "false");
     {
@@ -830,9 +1274,10 @@ std::string EthernetInterface::macAddress([[maybe_unused]] std::string value)
     if (newMAC != oldMAC)
     {
         // Update everything that depends on the MAC value
-        for (const auto& [_, intf] : manager.get().interfaces)
+        const auto& children = manager.get().vlanChildren;
+        if (auto it = children.find(ifIdx); it != children.end())
         {
-            if (intf->vlan && intf->vlan->parentIdx == ifIdx)
+            for (auto intf : it->second)
             {
                 intf->MacAddressIntf::macAddress(validMAC);
             }
@@ -913,6 +1358,13 @@ std::string EthernetInterface::defaultGateway(std::string gateway)
     if (gateway != defaultGateway())
     {
         gateway = EthernetInterfaceIntf::defaultGateway(std::move(gateway));
+        if (!gateway.empty())
+        {
+            manager.get().getApplyTracker().expect(
+                stats::ApplyOp::Gateway, ifIdx,
+                stdplus::InAnyAddr{
+                    stdplus::fromStr<stdplus::In4Addr>(gateway)});
+        }
         writeConfigurationFile();
         manager.get().reloadConfigs();
     }
@@ -925,6 +1377,13 @@ std::string EthernetInterface::defaultGateway6(std::string gateway)
     if (gateway != defaultGateway6())
     {
         gateway = EthernetInterfaceIntf::defaultGateway6(std::move(gateway));
+        if (!gateway.empty())
+        {
+            manager.get().getApplyTracker().expect(
+                stats::ApplyOp::Gateway, ifIdx,
+                stdplus::InAnyAddr{
+                    stdplus::fromStr<stdplus::In6Addr>(gateway)});
+        }
         writeConfigurationFile();
         manager.get().reloadConfigs();
     }
@@ -939,47 +1398,83 @@ EthernetInterface::VlanProperties::VlanProperties(
 {
     VlanIntf::id(*info.vlan_id, true);
     emit_object_added();
+    eth.get().manager.get().vlanChildren[parentIdx].emplace(&eth.get());
 }
 
-void EthernetInterface::VlanProperties::delete_()
+EthernetInterface::VlanProperties::~VlanProperties()
 {
+    unindex();
+}
+
+void EthernetInterface::VlanProperties::unindex()
+{
+    auto& children = eth.get().manager.get().vlanChildren;
+    if (auto it = children.find(parentIdx); it != children.end())
+    {
+        it->second.erase(&eth.get());
+        if (it->second.empty())
+        {
+            children.erase(it);
+        }
+    }
+}
+
+std::unique_ptr<EthernetInterface> EthernetInterface::VlanProperties::detach()
+{
+    auto& manager = eth.get().manager.get();
     auto intf = eth.get().interfaceName();
 
     // Remove all configs for the current interface
-    const auto& confDir = eth.get().manager.get().getConfDir();
+    const auto& confDir = manager.getConfDir();
     std::error_code ec;
     std::filesystem::remove(config::pathForIntfConf(confDir, intf), ec);
     std::filesystem::remove(config::pathForIntfDev(confDir, intf), ec);
 
-    if (eth.get().ifIdx > 0)
+    if (auto idx = eth.get().ifIdx; idx > 0)
     {
-        eth.get().manager.get().interfacesByIdx.erase(eth.get().ifIdx);
-    }
-    auto it = eth.get().manager.get().interfaces.find(intf);
-    auto obj = std::move(it->second);
-    eth.get().manager.get().interfaces.erase(it);
+        manager.links.erase(idx);
 
-    // Write an updated parent interface since it has a VLAN entry
-    for (const auto& [_, intf] : eth.get().manager.get().interfaces)
-    {
-        if (intf->ifIdx == parentIdx)
+        // Ignore the interface so neither the reload nor the events left
+        // over from the link going away bring it back, until RTM_DELLINK
+        manager.ignoredIntf.emplace(idx);
+
+        // We need to forcibly delete the interface as systemd does not
+        if (manager.directVlan)
+        {
+            try
+            {
+                system::deleteIntf(idx);
+            }
+            catch (const std::exception& e)
+            {
+                lg2::error("Failed to delete VLAN link: {ERROR}", "ERROR", e);
+            }
+        }
+        else
         {
-            intf->writeConfigurationFile();
+            manager.addReloadPostHook([idx]() { system::deleteIntf(idx); });
         }
     }
+    auto it = manager.interfaces.find(intf);
+    auto obj = std::move(it->second);
+    manager.interfaces.erase(it);
+    unindex();
+    return obj;
+}
 
-    if (eth.get().ifIdx > 0)
-    {
-        // We need to forcibly delete the interface as systemd does not
-        eth.get().manager.get().addReloadPostHook([idx = eth.get().ifIdx]() {
-            system::deleteIntf(idx);
-        });
+void EthernetInterface::VlanProperties::delete_()
+{
+    auto& manager = eth.get().manager.get();
+    auto obj = detach();
 
-        // Ignore the interface so the reload doesn't re-query it
-        eth.get().manager.get().ignoredIntf.emplace(eth.get().ifIdx);
+    // Write an updated parent interface since it has a VLAN entry
+    if (auto pit = manager.links.find(parentIdx);
+        pit != manager.links.end() && pit->second.intf != nullptr)
+    {
+        pit->second.intf->writeConfigurationFile();
     }
 
-    eth.get().manager.get().reloadConfigs();
+    manager.reloadConfigs();
 }
 
 void EthernetInterface::reloadConfigs()
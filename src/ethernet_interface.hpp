@@ -2,9 +2,12 @@
 #include "dhcp_configuration.hpp"
 #include "ipaddress.hpp"
 #include "neighbor.hpp"
+#include "static_route.hpp"
+#include "statistics.hpp"
 #include "types.hpp"
 #include "xyz/openbmc_project/Network/IP/Create/server.hpp"
 #include "xyz/openbmc_project/Network/Neighbor/CreateStatic/server.hpp"
+#include "xyz/openbmc_project/Network/Route/CreateStatic/server.hpp"
 
 #include <sdbusplus/bus.hpp>
 #include <sdbusplus/server/object.hpp>
@@ -17,8 +20,11 @@
 #include <xyz/openbmc_project/Network/VLAN/server.hpp>
 #include <xyz/openbmc_project/Object/Delete/server.hpp>
 
+#include <memory>
 #include <optional>
+#include <span>
 #include <string>
+#include <tuple>
 #include <vector>
 
 namespace phosphor
@@ -31,6 +37,7 @@ using Ifaces = sdbusplus::server::object_t<
     sdbusplus::xyz::openbmc_project::Network::server::MACAddress,
     sdbusplus::xyz::openbmc_project::Network::IP::server::Create,
     sdbusplus::xyz::openbmc_project::Network::Neighbor::server::CreateStatic,
+    sdbusplus::xyz::openbmc_project::Network::Route::server::CreateStatic,
     sdbusplus::xyz::openbmc_project::Collection::server::DeleteAll>;
 
 using VlanIfaces = sdbusplus::server::object_t<
@@ -84,6 +91,22 @@ class EthernetInterface : public Ifaces
                       const AllIntfInfo& info, std::string_view objRoot,
                       const config::Parser& config, bool enabled);
 
+    /** @brief Constructor republishing a renamed link under its new name.
+     *         The kernel state of the link, its addresses, neighbors,
+     *         gateways and static routes, is taken over from the object it
+     *         replaces, and only the settings come from the config of the
+     *         new name. Routes in that config win over the carried ones.
+     *  @param[in] bus - Bus to attach to.
+     *  @param[in] info - Interface information under the new name.
+     *  @param[in] objRoot - Path to attach at.
+     *  @param[in] config - The parsed configuration file of the new name.
+     *  @param[in] old - The object published under the old name.
+     */
+    EthernetInterface(stdplus::PinnedRef<sdbusplus::bus_t> bus,
+                      const InterfaceInfo& info, std::string_view objRoot,
+                      const config::Parser& config,
+                      const EthernetInterface& old);
+
     /** @brief Network Manager object. */
     stdplus::PinnedRef<Manager> manager;
 
@@ -94,9 +117,19 @@ class EthernetInterface : public Ifaces
     std::unordered_map<stdplus::InAnyAddr, std::unique_ptr<Neighbor>>
         staticNeighbors;
 
+    /** @brief Persistent map of StaticRoute dbus objects by destination */
+    std::unordered_map<stdplus::SubnetAny, std::unique_ptr<StaticRoute>>
+        staticRoutes;
+
     void addAddr(const AddressInfo& info);
     void addStaticNeigh(const NeighborInfo& info);
 
+    /** @brief Kernel index of the link, 0 until the kernel reports it */
+    inline unsigned getIfIdx() const noexcept
+    {
+        return ifIdx;
+    }
+
     /** @brief Updates the interface information based on new InterfaceInfo */
     void updateInfo(const InterfaceInfo& info, bool skipSignal = false);
 
@@ -123,6 +156,44 @@ class EthernetInterface : public Ifaces
      */
     ObjectPath neighbor(std::string ipAddress, std::string macAddress) override;
 
+    /** @brief Function to create many static neighbor dbus objects with a
+     *         single config write and reload.
+     *  @param[in] neighbors - IP and MAC address of each neighbor.
+     */
+    std::vector<ObjectPath> neighbors(
+        std::vector<std::tuple<std::string, std::string>> neighbors) override;
+
+    /** @brief Lists the static neighbors as taken by neighbors() */
+    std::vector<std::tuple<std::string, std::string>>
+        exportNeighbors() override;
+
+    /** @brief Function to create or update a static route dbus object.
+     *  @param[in] destination - Network address of the destination.
+     *  @param[in] prefixLength - Prefix length of the destination.
+     *  @param[in] gateway - Next hop, empty if directly reachable.
+     *  @param[in] metric - Priority of the route.
+     */
+    ObjectPath route(std::string destination, uint8_t prefixLength,
+                     std::string gateway, uint32_t metric) override;
+
+    /** @brief Replaces all of the static routes, programming the kernel with
+     *         a single batch of requests.
+     *  @param[in] routes - Destination, prefix length, gateway and metric
+     *                      of each route.
+     */
+    std::vector<ObjectPath> setRoutes(
+        std::vector<std::tuple<std::string, uint8_t, std::string, uint32_t>>
+            routes) override;
+
+    /** @brief Writes the config and programs the route changes into the
+     *         kernel, falling back to a reload of networkd if the link is
+     *         missing or the kernel rejects any of them.
+     *  @param[in] del - Routes to remove, as last programmed.
+     *  @param[in] add - Routes to add or replace.
+     */
+    void applyRoutes(std::span<const RouteInfo> del,
+                     std::span<const RouteInfo> add);
+
     /** Set value of DHCPEnabled */
     DHCPConf dhcpEnabled() const override;
     DHCPConf dhcpEnabled(DHCPConf value) override;
@@ -186,6 +257,19 @@ class EthernetInterface : public Ifaces
      */
     ObjectPath createVLAN(uint16_t id);
 
+    /** @brief create Vlan interfaces with a single parent config write and
+     *         reload. Nothing is created unless all of them can be.
+     *  @param[in] ids - VLAN identifiers.
+     *  @returns the object paths of the VLANs, in the order of ids.
+     */
+    std::vector<ObjectPath> createVLANs(std::span<const uint16_t> ids);
+
+    /** @brief delete Vlan interfaces with a single parent config write and
+     *         reload. Nothing is deleted unless all of them exist.
+     *  @param[in] ids - VLAN identifiers.
+     */
+    void deleteVLANs(std::span<const uint16_t> ids);
+
     /** @brief write the network conf file with the in-memory objects.
      */
     void writeConfigurationFile();
@@ -218,12 +302,12 @@ class EthernetInterface : public Ifaces
     using EthernetInterfaceIntf::defaultGateway6;
 
   protected:
-    /** @brief get the NTP server list from the timsyncd dbus obj
+    /** @brief get the NTP server list mirrored from timesyncd
      *
      */
     virtual ServerList getNTPServerFromTimeSyncd();
 
-    /** @brief get the name server details from the network conf
+    /** @brief get the name server list mirrored from resolved
      *
      */
     virtual ServerList getNameServerFromResolvd() const;
@@ -242,9 +326,18 @@ class EthernetInterface : public Ifaces
         VlanProperties(sdbusplus::bus_t& bus, stdplus::const_zstring objPath,
                        const InterfaceInfo& info,
                        stdplus::PinnedRef<EthernetInterface> eth);
+        ~VlanProperties();
         void delete_() override;
+        /** @brief Removes the VLAN configs and unpublishes the VLAN, leaving
+         *         the parent config and the reload to the caller
+         *  @returns the VLAN interface, to be destroyed by the caller
+         */
+        std::unique_ptr<EthernetInterface> detach();
+        /** @brief Drops this VLAN from its parent's children */
+        void unindex();
         unsigned parentIdx;
         stdplus::PinnedRef<EthernetInterface> eth;
+        [[no_unique_address]] stats::LiveObject<stats::Object::VLAN> live;
     };
     std::optional<VlanProperties> vlan;
 
@@ -254,10 +347,32 @@ class EthernetInterface : public Ifaces
     friend class TestNetworkManager;
 
   private:
+    [[no_unique_address]] stats::LiveObject<stats::Object::Interface> live;
+
+    /** @brief Destination, gateway and metric of a static route */
+    using RouteSpec = std::tuple<stdplus::SubnetAny,
+                                 std::optional<stdplus::InAnyAddr>, uint32_t>;
+
+    /** @brief Creates or updates the static routes, deleting all of the
+     *         others if exclusive, and applies the changes at once
+     */
+    std::vector<ObjectPath> updateRoutes(std::span<const RouteSpec> routes,
+                                         bool exclusive);
+
     EthernetInterface(stdplus::PinnedRef<sdbusplus::bus_t> bus,
                       stdplus::PinnedRef<Manager> manager,
                       const AllIntfInfo& info, std::string&& objPath,
                       const config::Parser& config, bool enabled);
+    EthernetInterface(stdplus::PinnedRef<sdbusplus::bus_t> bus,
+                      const InterfaceInfo& info, std::string&& objPath,
+                      const config::Parser& config,
+                      const EthernetInterface& old);
+
+    /** @brief Publishes the VLAN, DHCP and static route objects configured
+     *         for the interface
+     */
+    void addConfigured(const InterfaceInfo& info,
+                       const config::Parser& config);
 };
 
 } // namespace network
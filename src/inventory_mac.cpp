@@ -6,25 +6,23 @@
 #include "types.hpp"
 
 #include <nlohmann/json.hpp>
-#include <phosphor-logging/elog-errors.hpp>
 #include <phosphor-logging/lg2.hpp>
 #include <sdbusplus/bus.hpp>
 #include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/slot.hpp>
 #include <stdplus/str/maps.hpp>
-#include <xyz/openbmc_project/Common/error.hpp>
 
 #include <filesystem>
 #include <fstream>
 #include <memory>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace phosphor::network::inventory
 {
 
-using phosphor::logging::elog;
-using sdbusplus::xyz::openbmc_project::Common::Error::InternalFailure;
-
 using DbusObjectPath = std::string;
 using DbusInterface = std::string;
 using PropertyValue = std::string;
@@ -50,6 +48,16 @@ std::unique_ptr<sdbusplus::bus::match_t> MacAddressMatch = nullptr;
 std::vector<std::string> first_boot_status;
 nlohmann::json configJson;
 
+/** @brief Inventory objects cached from the mapper, fetched concurrently
+ *         with the rest of startup instead of once per interface.
+ */
+ObjectTree objectTree;
+bool objectTreeValid = false;
+bool objectTreePending = false;
+std::optional<sdbusplus::slot_t> subTreeCall;
+std::vector<std::string> pendingIntfs;
+stdplus::string_umap<sdbusplus::slot_t> macCalls;
+
 void setFirstBootMACOnInterface(const std::string& intf, const std::string& mac)
 {
     for (const auto& interface : manager->interfaces)
@@ -76,134 +84,198 @@ void setFirstBootMACOnInterface(const std::string& intf, const std::string& mac)
     }
 }
 
-stdplus::EtherAddr getfromInventory(sdbusplus::bus_t& bus,
-                                    const std::string& intfName)
+std::optional<std::pair<DbusObjectPath, DbusService>>
+    findInventoryObject(const std::string& intfName)
 {
     std::string interfaceName = configJson[intfName];
 
-    std::vector<DbusInterface> interfaces;
-    interfaces.emplace_back(invNetworkIntf);
-
-    auto depth = 0;
-
-    auto mapperCall =
-        bus.new_method_call(mapperBus, mapperObj, mapperIntf, "GetSubTree");
-
-    mapperCall.append(invRoot, depth, interfaces);
-
-    auto mapperReply = bus.call(mapperCall);
-    if (mapperReply.is_method_error())
-    {
-        lg2::error("Error in mapper call");
-        elog<InternalFailure>();
-    }
-
-    ObjectTree objectTree;
-    mapperReply.read(objectTree);
-
     if (objectTree.empty())
     {
         lg2::error("No Object has implemented the interface {NET_INTF}",
                    "NET_INTF", invNetworkIntf);
-        elog<InternalFailure>();
+        return std::nullopt;
     }
 
-    DbusObjectPath objPath;
-    DbusService service;
-
     if (1 == objectTree.size())
     {
-        objPath = objectTree.begin()->first;
-        service = objectTree.begin()->second.begin()->first;
+        return std::make_pair(objectTree.begin()->first,
+                              objectTree.begin()->second.begin()->first);
     }
-    else
+
+    // If there are more than 2 objects, object path must contain the
+    // interface name
+    for (const auto& object : objectTree)
     {
-        // If there are more than 2 objects, object path must contain the
-        // interface name
-        for (const auto& object : objectTree)
-        {
-            lg2::info("Get info on interface {NET_INTF}, object {OBJ}",
-                      "NET_INTF", interfaceName, "OBJ", object.first);
+        lg2::info("Get info on interface {NET_INTF}, object {OBJ}", "NET_INTF",
+                  interfaceName, "OBJ", object.first);
 
-            if (std::string::npos != object.first.find(interfaceName.c_str()))
-            {
-                objPath = object.first;
-                service = object.second.begin()->first;
-                break;
-            }
+        if (std::string::npos != object.first.find(interfaceName.c_str()))
+        {
+            return std::make_pair(object.first, object.second.begin()->first);
         }
+    }
 
-        if (objPath.empty())
+    lg2::error("Can't find the object for the interface {NET_INTF}",
+               "NET_INTF", interfaceName);
+    return std::nullopt;
+}
+
+bool applyInventoryMAC(const std::string& intfname,
+                       stdplus::EtherAddr inventoryMAC)
+{
+    if (inventoryMAC == stdplus::EtherAddr{})
+    {
+        lg2::info("Nothing is present in Inventory");
+        return false;
+    }
+    auto macStr = stdplus::toStr(inventoryMAC);
+    lg2::info("Mac Address {NET_MAC} in Inventory on Interface {NET_INTF}",
+              "NET_MAC", macStr, "NET_INTF", intfname);
+    setFirstBootMACOnInterface(intfname, macStr);
+    first_boot_status.push_back(intfname);
+    bool status = true;
+    for (const auto& keys : configJson.items())
+    {
+        if (!(std::find(first_boot_status.begin(), first_boot_status.end(),
+                        keys.key()) != first_boot_status.end()))
         {
-            lg2::error("Can't find the object for the interface {NET_INTF}",
-                       "NET_INTF", interfaceName);
-            elog<InternalFailure>();
+            lg2::info("Interface {NET_INTF} MAC is NOT set from VPD",
+                      "NET_INTF", keys.key());
+            status = false;
         }
     }
+    if (status)
+    {
+        lg2::info("Removing the match for ethernet interfaces");
+        EthInterfaceMatch = nullptr;
+    }
+    return true;
+}
+
+void getfromInventory(sdbusplus::bus_t& bus, const std::string& intfname)
+{
+    auto obj = findInventoryObject(intfname);
+    if (!obj)
+    {
+        return;
+    }
+    const auto& objPath = obj->first;
+    const auto& service = obj->second;
 
     auto method = bus.new_method_call(service.c_str(), objPath.c_str(),
                                       propIntf, methodGet);
 
     method.append(invNetworkIntf, "MACAddress");
 
-    auto reply = bus.call(method);
-    if (reply.is_method_error())
-    {
-        lg2::error(
-            "Failed to get MACAddress for path {DBUS_PATH} interface {DBUS_INTF}",
-            "DBUS_PATH", objPath, "DBUS_INTF", invNetworkIntf);
-        elog<InternalFailure>();
-    }
-
-    std::variant<std::string> value;
-    reply.read(value);
-    return stdplus::fromStr<stdplus::EtherAddr>(std::get<std::string>(value));
+    macCalls.insert_or_assign(
+        intfname,
+        method.call_async([intfname, objPath](sdbusplus::message_t& reply) {
+            if (reply.is_method_error())
+            {
+                lg2::error(
+                    "Failed to get MACAddress for path {DBUS_PATH} interface {DBUS_INTF}",
+                    "DBUS_PATH", objPath, "DBUS_INTF", invNetworkIntf);
+                return;
+            }
+            try
+            {
+                std::variant<std::string> value;
+                reply.read(value);
+                if (applyInventoryMAC(
+                        intfname, stdplus::fromStr<stdplus::EtherAddr>(
+                                      std::get<std::string>(value))))
+                {
+                    MacAddressMatch = nullptr;
+                }
+            }
+            catch (const std::exception& e)
+            {
+                lg2::error("Exception occurred during getting of MAC "
+                           "address from Inventory");
+            }
+        }));
 }
 
-bool setInventoryMACOnSystem(sdbusplus::bus_t& bus, const std::string& intfname)
+// Fetch the inventory objects once and resolve all of the interfaces that
+// were waiting for them
+void fetchObjectTree(sdbusplus::bus_t& bus, Startup::Ticket&& ticket)
 {
-    try
-    {
-        auto inventoryMAC = getfromInventory(bus, intfname);
-        if (inventoryMAC != stdplus::EtherAddr{})
-        {
-            auto macStr = stdplus::toStr(inventoryMAC);
-            lg2::info(
-                "Mac Address {NET_MAC} in Inventory on Interface {NET_INTF}",
-                "NET_MAC", macStr, "NET_INTF", intfname);
-            setFirstBootMACOnInterface(intfname, macStr);
-            first_boot_status.push_back(intfname);
-            bool status = true;
-            for (const auto& keys : configJson.items())
+    std::vector<DbusInterface> interfaces;
+    interfaces.emplace_back(invNetworkIntf);
+
+    auto depth = 0;
+
+    auto mapperCall =
+        bus.new_method_call(mapperBus, mapperObj, mapperIntf, "GetSubTree");
+
+    mapperCall.append(invRoot, depth, interfaces);
+
+    objectTreePending = true;
+    subTreeCall.emplace(mapperCall.call_async(
+        [&bus, ticket = std::move(ticket)](
+            sdbusplus::message_t& mapperReply) mutable {
+            auto done = std::move(ticket);
+            objectTreePending = false;
+            auto pending = std::exchange(pendingIntfs, {});
+            if (mapperReply.is_method_error())
             {
-                if (!(std::find(first_boot_status.begin(),
-                                first_boot_status.end(), keys.key()) !=
-                      first_boot_status.end()))
+                lg2::error("Error in mapper call");
+                return;
+            }
+            try
+            {
+                objectTree.clear();
+                mapperReply.read(objectTree);
+                objectTreeValid = true;
+                for (const auto& intfname : pending)
                 {
-                    lg2::info("Interface {NET_INTF} MAC is NOT set from VPD",
-                              "NET_INTF", keys.key());
-                    status = false;
+                    getfromInventory(bus, intfname);
                 }
             }
-            if (status)
+            catch (const std::exception& e)
             {
-                lg2::info("Removing the match for ethernet interfaces");
-                EthInterfaceMatch = nullptr;
+                lg2::error("Exception occurred during getting of MAC "
+                           "address from Inventory");
             }
+        }));
+}
+
+/** @brief Drops the cached inventory objects after one was added, so the
+ *         next lookup queries the mapper again
+ */
+void invalidateObjectTree(sdbusplus::bus_t& bus)
+{
+    objectTree.clear();
+    objectTreeValid = false;
+    if (objectTreePending)
+    {
+        // The reply in flight may predate the new object
+        subTreeCall.reset();
+        objectTreePending = false;
+        fetchObjectTree(bus, {});
+    }
+}
+
+void setInventoryMACOnSystem(sdbusplus::bus_t& bus, const std::string& intfname)
+{
+    try
+    {
+        if (objectTreeValid)
+        {
+            getfromInventory(bus, intfname);
+            return;
         }
-        else
+        pendingIntfs.push_back(intfname);
+        if (!objectTreePending)
         {
-            lg2::info("Nothing is present in Inventory");
-            return false;
+            fetchObjectTree(bus, {});
         }
     }
     catch (const std::exception& e)
     {
         lg2::error("Exception occurred during getting of MAC "
                    "address from Inventory");
-        return false;
     }
-    return true;
 }
 
 // register the matches to be monitored from inventory manager
@@ -219,6 +291,11 @@ void registerSignals(sdbusplus::bus_t& bus)
         sdbusplus::message::object_path objPath;
         m.read(objPath, interfacesProperties);
 
+        if (interfacesProperties.contains(invNetworkIntf))
+        {
+            invalidateObjectTree(bus);
+        }
+
         for (const auto& pattern : configJson.items())
         {
             if (objPath.str.find(pattern.value()) != std::string::npos)
@@ -268,11 +345,7 @@ void watchEthernetInterface(sdbusplus::bus_t& bus)
         else
         {
             registerSignals(bus);
-
-            if (setInventoryMACOnSystem(bus, infname))
-            {
-                MacAddressMatch = nullptr;
-            }
+            setInventoryMACOnSystem(bus, infname);
         }
     };
 
@@ -316,6 +389,19 @@ void watchEthernetInterface(sdbusplus::bus_t& bus)
         if (FORCE_SYNC_MAC_FROM_INVENTORY ||
             !std::filesystem::exists(firstBootPath + interfaceString.key()))
         {
+            if (!objectTreeValid && !objectTreePending)
+            {
+                try
+                {
+                    fetchObjectTree(bus,
+                                    manager->getStartup().begin("inventory"));
+                }
+                catch (const std::exception& e)
+                {
+                    lg2::error("Exception occurred during getting of MAC "
+                               "address from Inventory");
+                }
+            }
             lg2::info("Check VPD for MAC: {REASON}", "REASON",
                       (FORCE_SYNC_MAC_FROM_INVENTORY)
                           ? "Force sync enabled"
@@ -337,6 +423,18 @@ void watchEthernetInterface(sdbusplus::bus_t& bus)
     }
 }
 
+/** @brief Cancels the outstanding inventory queries before the manager
+ *         they report to goes away.
+ */
+struct QueryRuntime : Runtime
+{
+    ~QueryRuntime() override
+    {
+        subTreeCall.reset();
+        macCalls.clear();
+    }
+};
+
 std::unique_ptr<Runtime> watch(stdplus::PinnedRef<sdbusplus::bus_t> bus,
                                stdplus::PinnedRef<Manager> m)
 {
@@ -344,7 +442,7 @@ std::unique_ptr<Runtime> watch(stdplus::PinnedRef<sdbusplus::bus_t> bus,
     std::ifstream in(configFile);
     in >> configJson;
     watchEthernetInterface(bus);
-    return nullptr;
+    return std::make_unique<QueryRuntime>();
 }
 
 } // namespace phosphor::network::inventory
@@ -57,7 +57,7 @@ IPAddress::IPAddress(sdbusplus::bus_t& bus,
                      stdplus::PinnedRef<EthernetInterface> parent,
                      stdplus::SubnetAny addr, AddressOrigin origin) :
     IPIfaces(bus, objPath.str.c_str(), IPIfaces::action::defer_emit),
-    parent(parent), objPath(std::move(objPath))
+    parent(parent), objPath(std::move(objPath)), ifaddr(addr)
 {
     IP::address(stdplus::toStr(addr.getAddr()), true);
     IP::prefixLength(addr.getPfx(), true);
@@ -101,14 +101,10 @@ void IPAddress::delete_()
 
     std::unique_ptr<IPAddress> ptr;
     auto& addrs = parent.get().addrs;
-    for (auto it = addrs.begin(); it != addrs.end(); ++it)
+    if (auto it = addrs.find(ifaddr); it != addrs.end())
     {
-        if (it->second.get() == this)
-        {
-            ptr = std::move(it->second);
-            addrs.erase(it);
-            break;
-        }
+        ptr = std::move(it->second);
+        addrs.erase(it);
     }
 
     parent.get().writeConfigurationFile();
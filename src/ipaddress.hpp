@@ -1,4 +1,5 @@
 #pragma once
+#include "statistics.hpp"
 #include "types.hpp"
 
 #include <sdbusplus/bus.hpp>
@@ -71,6 +72,11 @@ class IPAddress : public IPIfaces
     /** @brief Dbus object path */
     sdbusplus::message::object_path objPath;
 
+    /** @brief Key of this object in the parent's address map */
+    stdplus::SubnetAny ifaddr;
+
+    [[no_unique_address]] stats::LiveObject<stats::Object::IPAddress> live;
+
     IPAddress(sdbusplus::bus_t& bus, sdbusplus::message::object_path objPath,
               stdplus::PinnedRef<EthernetInterface> parent,
               stdplus::SubnetAny addr, IP::AddressOrigin origin);
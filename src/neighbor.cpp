@@ -35,7 +35,7 @@ Neighbor::Neighbor(sdbusplus::bus_t& bus,
                    stdplus::InAnyAddr addr, stdplus::EtherAddr lladdr,
                    State state) :
     NeighborObj(bus, objPath.str.c_str(), NeighborObj::action::defer_emit),
-    parent(parent), objPath(std::move(objPath))
+    parent(parent), objPath(std::move(objPath)), addr(addr)
 {
     NeighborObj::ipAddress(stdplus::toStr(addr), true);
     NeighborObj::macAddress(stdplus::toStr(lladdr), true);
@@ -47,14 +47,10 @@ void Neighbor::delete_()
 {
     auto& neighbors = parent.get().staticNeighbors;
     std::unique_ptr<Neighbor> ptr;
-    for (auto it = neighbors.begin(); it != neighbors.end(); ++it)
+    if (auto it = neighbors.find(addr); it != neighbors.end())
     {
-        if (it->second.get() == this)
-        {
-            ptr = std::move(it->second);
-            neighbors.erase(it);
-            break;
-        }
+        ptr = std::move(it->second);
+        neighbors.erase(it);
     }
 
     parent.get().writeConfigurationFile();
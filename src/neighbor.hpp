@@ -1,4 +1,5 @@
 #pragma once
+#include "statistics.hpp"
 #include "types.hpp"
 
 #include <sdbusplus/bus.hpp>
@@ -65,6 +66,11 @@ class Neighbor : public NeighborObj
     /** @brief Dbus object path */
     sdbusplus::message::object_path objPath;
 
+    /** @brief Key of this object in the parent's neighbor map */
+    stdplus::InAnyAddr addr;
+
+    [[no_unique_address]] stats::LiveObject<stats::Object::Neighbor> live;
+
     Neighbor(sdbusplus::bus_t& bus, sdbusplus::message::object_path objPath,
              stdplus::PinnedRef<EthernetInterface> parent,
              stdplus::InAnyAddr addr, stdplus::EtherAddr lladdr, State state);
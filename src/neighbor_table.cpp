@@ -0,0 +1,102 @@
+#include "neighbor_table.hpp"
+
+#include <linux/neighbour.h>
+
+#include <cstring>
+#include <type_traits>
+#include <variant>
+
+namespace phosphor
+{
+namespace network
+{
+
+bool NeighborTable::Key::operator<(const Key& rhs) const noexcept
+{
+    if (ifidx != rhs.ifidx)
+    {
+        return ifidx < rhs.ifidx;
+    }
+    if (addr.index() != rhs.addr.index())
+    {
+        return addr.index() < rhs.addr.index();
+    }
+    return std::visit(
+        [&](const auto& a) {
+            using T = std::decay_t<decltype(a)>;
+            return std::memcmp(&a, &std::get<T>(rhs.addr), sizeof(a)) < 0;
+        },
+        addr);
+}
+
+void NeighborTable::updateInt(const NeighborInfo& info)
+{
+    if (!info.addr)
+    {
+        return;
+    }
+    auto& entry = entries[Key{info.ifidx, *info.addr}];
+    entry.mac = info.mac.value_or(stdplus::EtherAddr{});
+    entry.state = info.state;
+    entry.updated = stats::Clock::now();
+}
+
+void NeighborTable::forget(unsigned ifidx)
+{
+    auto [first, last] = range(ifidx);
+    entries.erase(first, last);
+}
+
+std::pair<NeighborTable::Map::const_iterator,
+          NeighborTable::Map::const_iterator>
+    NeighborTable::range(std::optional<unsigned> ifidx) const
+{
+    if (!ifidx)
+    {
+        return {entries.begin(), entries.end()};
+    }
+    // The lowest key of an interface is its all zero IPv4 address
+    auto first = entries.lower_bound(Key{*ifidx, stdplus::In4Addr{}});
+    auto last = entries.lower_bound(Key{*ifidx + 1, stdplus::In4Addr{}});
+    return {first, last};
+}
+
+std::string_view neighStateStr(uint16_t state) noexcept
+{
+    if (state & NUD_PERMANENT)
+    {
+        return "PERMANENT";
+    }
+    if (state & NUD_NOARP)
+    {
+        return "NOARP";
+    }
+    if (state & NUD_REACHABLE)
+    {
+        return "REACHABLE";
+    }
+    if (state & NUD_STALE)
+    {
+        return "STALE";
+    }
+    if (state & NUD_DELAY)
+    {
+        return "DELAY";
+    }
+    if (state & NUD_PROBE)
+    {
+        return "PROBE";
+    }
+    if (state & NUD_INCOMPLETE)
+    {
+        return "INCOMPLETE";
+    }
+    if (state & NUD_FAILED)
+    {
+        return "FAILED";
+    }
+    return "NONE";
+}
+
+} // namespace network
+} // namespace phosphor
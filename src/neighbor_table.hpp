@@ -0,0 +1,104 @@
+#pragma once
+#include "statistics.hpp"
+#include "types.hpp"
+
+#include <stdplus/net/addr/ether.hpp>
+#include <stdplus/net/addr/ip.hpp>
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+namespace phosphor
+{
+namespace network
+{
+
+/** @class NeighborTable
+ *  @brief Mirror of the kernel neighbor cache, dynamic entries included.
+ *  @details Nothing is kept until the table is enabled by its first query,
+ *           so feeding it rtnetlink events is free until someone asks for
+ *           it. Entries are ordered by interface index and then address, so
+ *           the neighbors of an interface are contiguous.
+ */
+class NeighborTable
+{
+  public:
+    struct Key
+    {
+        unsigned ifidx;
+        stdplus::InAnyAddr addr;
+
+        bool operator<(const Key& rhs) const noexcept;
+    };
+
+    struct Entry
+    {
+        /** @brief All zeros while the link layer address is unknown */
+        stdplus::EtherAddr mac;
+        uint16_t state;
+        stats::Clock::time_point updated;
+    };
+
+    using Map = std::map<Key, Entry>;
+
+    inline bool enabled() const noexcept
+    {
+        return on;
+    }
+
+    /** @brief Starts mirroring, to be followed by a dump of the cache */
+    inline void enable() noexcept
+    {
+        on = true;
+    }
+
+    /** @brief Stops mirroring and frees the entries */
+    inline void disable() noexcept
+    {
+        on = false;
+        entries.clear();
+    }
+
+    /** @brief Applies an RTM_NEWNEIGH / RTM_DELNEIGH once enabled */
+    inline void update(const NeighborInfo& info)
+    {
+        if (on)
+        {
+            updateInt(info);
+        }
+    }
+    inline void remove(const NeighborInfo& info)
+    {
+        if (on && info.addr)
+        {
+            entries.erase(Key{info.ifidx, *info.addr});
+        }
+    }
+
+    /** @brief Drops all of the entries of a removed interface */
+    void forget(unsigned ifidx);
+
+    /** @brief The entries of a single interface, or all of them */
+    std::pair<Map::const_iterator, Map::const_iterator>
+        range(std::optional<unsigned> ifidx) const;
+
+    inline size_t size() const noexcept
+    {
+        return entries.size();
+    }
+
+  private:
+    Map entries;
+    bool on = false;
+
+    void updateInt(const NeighborInfo& info);
+};
+
+/** @brief Name of the neighbor state as printed by `ip neigh` */
+std::string_view neighStateStr(uint16_t state) noexcept;
+
+} // namespace network
+} // namespace phosphor
@@ -1,5 +1,7 @@
 #include "netlink.hpp"
 
+#include "tracepoints.hpp"
+
 #include <linux/netlink.h>
 #include <linux/rtnetlink.h>
 
@@ -11,6 +13,7 @@
 #include <format>
 #include <stdexcept>
 #include <system_error>
+#include <unordered_map>
 
 using stdplus::raw::Aligned;
 
@@ -39,6 +42,8 @@ void processMsg(std::string_view& msgs, bool& done, ReceiveCallback cb)
             std::format("not enough message for nlmsg: {} < {}", msgs.size(),
                         hdr.nlmsg_len));
     }
+    NETWORKD_TRACE(netlink_msg, hdr.nlmsg_type, hdr.nlmsg_len,
+                   hdr.nlmsg_flags);
     auto msg = msgs.substr(NLMSG_HDRLEN, hdr.nlmsg_len - NLMSG_HDRLEN);
     msgs.remove_prefix(NLMSG_ALIGN(hdr.nlmsg_len));
 
@@ -117,16 +122,22 @@ static stdplus::ManagedFd makeSocket(int protocol)
     return sock;
 }
 
-void performRequest(int protocol, void* data, size_t size, ReceiveCallback cb)
+void performRequest(int protocol, void* data, size_t size, ReceiveCallback cb,
+                    DatagramCallback dgram)
 {
     auto sock = makeSocket(protocol);
     requestSend(sock.get(), data, size);
-    receive(sock.get(), cb);
+    receive(sock.get(), cb, dgram);
 }
 
 } // namespace detail
 
 size_t receive(int sock, ReceiveCallback cb)
+{
+    return receive(sock, cb, [](std::string_view) {});
+}
+
+size_t receive(int sock, ReceiveCallback cb, DatagramCallback dgram)
 {
     // We need to make sure we have enough room for an entire packet otherwise
     // it gets truncated. The netlink docs guarantee packets will not exceed 8K
@@ -165,7 +176,9 @@ size_t receive(int sock, ReceiveCallback cb)
             return num_msgs;
         }
 
+        NETWORKD_TRACE(netlink_receive, sock, recvd);
         std::string_view msgs(buf.data(), recvd);
+        dgram(msgs);
         do
         {
             detail::processMsg(msgs, done, cb);
@@ -180,6 +193,81 @@ size_t receive(int sock, ReceiveCallback cb)
     return num_msgs;
 }
 
+/** @brief Records the result of each ack in the datagram */
+static size_t collectAcks(std::string_view dgram,
+                          const std::unordered_map<uint32_t, size_t>& seqs,
+                          std::vector<int>& errs)
+{
+    size_t ret = 0;
+    while (!dgram.empty())
+    {
+        const auto& hdr = stdplus::raw::refFrom<nlmsghdr, Aligned>(dgram);
+        if (hdr.nlmsg_len < sizeof(hdr) || dgram.size() < hdr.nlmsg_len)
+        {
+            break;
+        }
+        auto msg = dgram.substr(NLMSG_HDRLEN, hdr.nlmsg_len - NLMSG_HDRLEN);
+        dgram.remove_prefix(
+            std::min<size_t>(dgram.size(), NLMSG_ALIGN(hdr.nlmsg_len)));
+        auto it = seqs.find(hdr.nlmsg_seq);
+        if (hdr.nlmsg_type != NLMSG_ERROR || it == seqs.end())
+        {
+            continue;
+        }
+        errs[it->second] = -stdplus::raw::refFrom<nlmsgerr, Aligned>(msg).error;
+        ++ret;
+    }
+    return ret;
+}
+
+std::vector<int> performBatch(int protocol, std::string_view msgs)
+{
+    return performBatch(protocol, msgs,
+                        [](const nlmsghdr&, std::string_view) {});
+}
+
+std::vector<int> performBatch(int protocol, std::string_view msgs,
+                              ReceiveCallback cb)
+{
+    std::unordered_map<uint32_t, size_t> seqs;
+    for (auto rest = msgs; !rest.empty();)
+    {
+        const auto& hdr = stdplus::raw::refFrom<nlmsghdr, Aligned>(rest);
+        if (hdr.nlmsg_len < sizeof(hdr) || rest.size() < hdr.nlmsg_len)
+        {
+            throw std::runtime_error(
+                std::format("Bad nlmsg length: {}", hdr.nlmsg_len));
+        }
+        if (!seqs.emplace(hdr.nlmsg_seq, seqs.size()).second)
+        {
+            throw std::runtime_error(
+                std::format("Duplicate nlmsg seq: {}", hdr.nlmsg_seq));
+        }
+        rest.remove_prefix(
+            std::min<size_t>(rest.size(), NLMSG_ALIGN(hdr.nlmsg_len)));
+    }
+
+    auto sock = detail::makeSocket(protocol);
+    detail::requestSend(sock.get(), const_cast<char*>(msgs.data()),
+                        msgs.size());
+
+    // The kernel acks each request separately, failures included, and
+    // only the datagrams show the failures
+    std::vector<int> ret(seqs.size(), 0);
+    size_t acked = 0;
+    while (acked < ret.size())
+    {
+        auto n = receive(sock.get(), cb, [&](std::string_view dgram) {
+            acked += collectAcks(dgram, seqs, ret);
+        });
+        if (n == 0)
+        {
+            throw std::runtime_error("netlink batch: missing acks");
+        }
+    }
+    return ret;
+}
+
 std::tuple<rtattr, std::string_view> extractRtAttr(std::string_view& data)
 {
     const auto& hdr = stdplus::raw::refFrom<rtattr, Aligned>(data);
@@ -8,6 +8,7 @@
 #include <string_view>
 #include <tuple>
 #include <type_traits>
+#include <vector>
 
 namespace phosphor
 {
@@ -21,20 +22,28 @@ namespace netlink
 using ReceiveCallback =
     stdplus::function_view<void(const nlmsghdr&, std::string_view)>;
 
+/* @brief Called on each raw datagram received on the socket, before any of
+ *        the messages it holds are handled
+ */
+using DatagramCallback = stdplus::function_view<void(std::string_view)>;
+
 namespace detail
 {
 
 void processMsg(std::string_view& msgs, bool& done, ReceiveCallback cb);
 
-void performRequest(int protocol, void* data, size_t size, ReceiveCallback cb);
+void performRequest(int protocol, void* data, size_t size, ReceiveCallback cb,
+                    DatagramCallback dgram);
 
 } // namespace detail
 
 /** @brief Receives all outstanding messages on a netlink socket
  *
- *  @param[in] sock - The socket to receive the messages on
- *  @param[in] cb   - Called for each response message payload
+ *  @param[in] sock  - The socket to receive the messages on
+ *  @param[in] cb    - Called for each response message payload
+ *  @param[in] dgram - Called for each datagram received
  */
+size_t receive(int sock, ReceiveCallback cb, DatagramCallback dgram);
 size_t receive(int sock, ReceiveCallback cb);
 
 /* @brief Call on an rtnetlink payload
@@ -67,10 +76,11 @@ std::tuple<rtattr, std::string_view> extractRtAttr(std::string_view& data);
  *  @param[in] flags    - Additional netlink flags for the request
  *  @param[in] msg      - The message payload for the request
  *  @param[in] cb       - Called for each response message payload
+ *  @param[in] dgram    - Called for each response datagram
  */
 template <typename T>
 void performRequest(int protocol, uint16_t type, uint16_t flags, const T& msg,
-                    ReceiveCallback cb)
+                    ReceiveCallback cb, DatagramCallback dgram)
 {
     static_assert(std::is_trivially_copyable_v<T>);
 
@@ -84,9 +94,51 @@ void performRequest(int protocol, uint16_t type, uint16_t flags, const T& msg,
     data.hdr.nlmsg_flags = NLM_F_REQUEST | NLM_F_ACK | flags;
     data.msg = msg;
 
-    detail::performRequest(protocol, &data, sizeof(data), cb);
+    detail::performRequest(protocol, &data, sizeof(data), cb, dgram);
 }
 
+template <typename T>
+void performRequest(int protocol, uint16_t type, uint16_t flags, const T& msg,
+                    ReceiveCallback cb)
+{
+    performRequest(protocol, type, flags, msg, cb, [](std::string_view) {});
+}
+
+/** @brief Performs a netlink request already laid out in a buffer, as built
+ *         by MsgBuilder. Calls the callback upon receiving
+ *
+ *  @param[in] protocol - The netlink protocol to use when opening the socket
+ *  @param[in] msgs     - The request, nlmsghdr included
+ *  @param[in] cb       - Called for each response message payload
+ */
+inline void performRequest(int protocol, std::string_view msgs,
+                           ReceiveCallback cb)
+{
+    detail::performRequest(protocol, const_cast<char*>(msgs.data()),
+                           msgs.size(), cb, [](std::string_view) {});
+}
+
+/** @brief Sends a batch of requests laid out in a buffer by MsgBuilder in a
+ *         single datagram, and waits for the acknowledgement of each. Every
+ *         request needs NLM_F_ACK and its own sequence number.
+ *
+ *  @param[in] protocol - The netlink protocol to use when opening the socket
+ *  @param[in] msgs     - The requests, nlmsghdr included
+ *  @return The errno of each request in order, 0 if it succeeded
+ */
+std::vector<int> performBatch(int protocol, std::string_view msgs);
+
+/** @brief Same as above, also calling the callback on each reply that is
+ *         not an ack, like echoes and lookup results
+ *
+ *  @param[in] protocol - The netlink protocol to use when opening the socket
+ *  @param[in] msgs     - The requests, nlmsghdr included
+ *  @param[in] cb       - Called for each response message payload
+ *  @return The errno of each request in order, 0 if it succeeded
+ */
+std::vector<int> performBatch(int protocol, std::string_view msgs,
+                              ReceiveCallback cb);
+
 } // namespace netlink
 } // namespace network
 } // namespace phosphor
@@ -0,0 +1,148 @@
+#include "netlink_capture.hpp"
+
+#include <endian.h>
+#include <linux/if_packet.h>
+#include <linux/netlink.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <format>
+#include <stdexcept>
+
+namespace phosphor
+{
+namespace network
+{
+namespace netlink
+{
+
+static constexpr uint32_t pcapMagicMicros = 0xa1b2c3d4;
+static constexpr uint32_t pcapMagicNanos = 0xa1b23c4d;
+static constexpr uint32_t snapLen = 65535;
+// ARPHRD_NETLINK, missing from the libc headers
+static constexpr uint16_t arphrdNetlink = 824;
+
+struct PcapHeader
+{
+    uint32_t magic;
+    uint16_t versionMajor;
+    uint16_t versionMinor;
+    int32_t thiszone;
+    uint32_t sigfigs;
+    uint32_t snaplen;
+    uint32_t linktype;
+};
+
+struct PcapRecord
+{
+    uint32_t sec;
+    uint32_t subsec;
+    uint32_t inclLen;
+    uint32_t origLen;
+};
+
+/** @brief The LINKTYPE_NETLINK pseudo header, all fields big endian */
+struct CookedHeader
+{
+    uint16_t pktType;
+    uint16_t arphrdType;
+    uint16_t addrLen;
+    uint8_t addr[8];
+    uint16_t protocol;
+};
+static_assert(sizeof(CookedHeader) == 16);
+
+Capture::Capture(const std::filesystem::path& path) :
+    out(path, std::ios::binary | std::ios::trunc)
+{
+    if (!out)
+    {
+        throw std::runtime_error(
+            std::format("Failed to create capture `{}`", path.native()));
+    }
+    PcapHeader hdr = {};
+    hdr.magic = pcapMagicNanos;
+    hdr.versionMajor = 2;
+    hdr.versionMinor = 4;
+    hdr.snaplen = snapLen;
+    hdr.linktype = linktypeNetlink;
+    out.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+    out.flush();
+}
+
+void Capture::record(std::string_view datagram,
+                     std::chrono::system_clock::time_point time)
+{
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  time.time_since_epoch())
+                  .count();
+    CookedHeader cooked = {};
+    cooked.pktType = htobe16(PACKET_HOST);
+    cooked.arphrdType = htobe16(arphrdNetlink);
+    cooked.protocol = htobe16(NETLINK_ROUTE);
+    PcapRecord rec = {};
+    rec.sec = ns / 1000000000;
+    rec.subsec = ns % 1000000000;
+    rec.origLen = sizeof(cooked) + datagram.size();
+    rec.inclLen = std::min<uint32_t>(rec.origLen, snapLen);
+    out.write(reinterpret_cast<const char*>(&rec), sizeof(rec));
+    out.write(reinterpret_cast<const char*>(&cooked), sizeof(cooked));
+    out.write(datagram.data(), rec.inclLen - sizeof(cooked));
+    // Keep everything up to the last datagram if we are killed
+    out.flush();
+}
+
+CaptureReader::CaptureReader(const std::filesystem::path& path) :
+    in(path, std::ios::binary)
+{
+    PcapHeader hdr;
+    if (!in.read(reinterpret_cast<char*>(&hdr), sizeof(hdr)))
+    {
+        throw std::runtime_error(
+            std::format("Failed to read capture `{}`", path.native()));
+    }
+    if (hdr.magic == pcapMagicNanos)
+    {
+        nanos = true;
+    }
+    else if (hdr.magic != pcapMagicMicros)
+    {
+        throw std::runtime_error(
+            std::format("Not a native pcap file: {:#x}", hdr.magic));
+    }
+    if (hdr.linktype != linktypeNetlink)
+    {
+        throw std::runtime_error(
+            std::format("Not a netlink capture: linktype {}", hdr.linktype));
+    }
+}
+
+std::optional<CapturedDatagram> CaptureReader::next()
+{
+    PcapRecord rec;
+    if (!in.read(reinterpret_cast<char*>(&rec), sizeof(rec)))
+    {
+        return std::nullopt;
+    }
+    if (rec.inclLen < sizeof(CookedHeader) || rec.inclLen != rec.origLen)
+    {
+        throw std::runtime_error(
+            std::format("Bad capture record: {} of {} bytes", rec.inclLen,
+                        rec.origLen));
+    }
+    CapturedDatagram ret;
+    ret.time = std::chrono::seconds(rec.sec) +
+               (nanos ? std::chrono::nanoseconds(rec.subsec)
+                      : std::chrono::microseconds(rec.subsec));
+    ret.data.resize(rec.inclLen);
+    if (!in.read(ret.data.data(), ret.data.size()))
+    {
+        throw std::runtime_error("Truncated capture record");
+    }
+    ret.data.erase(0, sizeof(CookedHeader));
+    return ret;
+}
+
+} // namespace netlink
+} // namespace network
+} // namespace phosphor
@@ -0,0 +1,69 @@
+#pragma once
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace phosphor
+{
+namespace network
+{
+namespace netlink
+{
+
+/** @brief The pcap link type for netlink, with a 16 byte cooked header
+ *         carrying ARPHRD_NETLINK and the netlink protocol
+ */
+inline constexpr uint32_t linktypeNetlink = 253;
+
+/** @class Capture
+ *  @brief Records received rtnetlink datagrams to a pcap file which
+ *         wireshark and tcpdump decode like an nlmon capture.
+ */
+class Capture
+{
+  public:
+    /** @brief Creates the capture file, replacing any existing one */
+    explicit Capture(const std::filesystem::path& path);
+
+    /** @brief Appends a datagram received at the given wall clock time */
+    void record(std::string_view datagram,
+                std::chrono::system_clock::time_point time);
+    inline void record(std::string_view datagram)
+    {
+        record(datagram, std::chrono::system_clock::now());
+    }
+
+  private:
+    std::ofstream out;
+};
+
+/** @brief A datagram read back from a capture */
+struct CapturedDatagram
+{
+    std::chrono::nanoseconds time;
+    std::string data;
+};
+
+/** @class CaptureReader
+ *  @brief Reads back the datagrams of a netlink pcap file in order. Both
+ *         microsecond and nanosecond resolution captures are accepted.
+ */
+class CaptureReader
+{
+  public:
+    explicit CaptureReader(const std::filesystem::path& path);
+
+    /** @brief Reads the next datagram, or nothing at the end of the file */
+    std::optional<CapturedDatagram> next();
+
+  private:
+    std::ifstream in;
+    bool nanos = false;
+};
+
+} // namespace netlink
+} // namespace network
+} // namespace phosphor
@@ -0,0 +1,142 @@
+#pragma once
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace phosphor::network::netlink
+{
+
+/** @class MsgBuilder
+ *  @brief Builds a buffer of netlink messages laid out exactly as the kernel
+ *         expects them. Used for the requests sent to the kernel, and by the
+ *         tests for feeding synthetic traffic to the parsers.
+ */
+class MsgBuilder
+{
+  public:
+    MsgBuilder()
+    {
+        buf.reserve(8192);
+    }
+
+    /** @brief Starts a new message in the buffer */
+    MsgBuilder& begin(uint16_t type, uint16_t flags = 0, uint32_t seq = 0,
+                      uint32_t pid = 0)
+    {
+        msgStart = buf.size();
+        nlmsghdr hdr{};
+        hdr.nlmsg_type = type;
+        hdr.nlmsg_flags = flags;
+        hdr.nlmsg_seq = seq;
+        hdr.nlmsg_pid = pid;
+        return append(&hdr, sizeof(hdr), NLMSG_ALIGNTO);
+    }
+
+    /** @brief Appends the fixed family header of the current message */
+    template <typename T>
+    MsgBuilder& data(const T& t)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        return append(&t, sizeof(t), NLMSG_ALIGNTO);
+    }
+
+    MsgBuilder& attr(uint16_t type, std::string_view data)
+    {
+        rtattr hdr{};
+        hdr.rta_type = type;
+        hdr.rta_len = RTA_LENGTH(data.size());
+        append(&hdr, sizeof(hdr), RTA_ALIGNTO);
+        return append(data.data(), data.size(), RTA_ALIGNTO);
+    }
+
+    template <typename T>
+    MsgBuilder& attr(uint16_t type, const T& t)
+        requires std::is_trivially_copyable_v<T>
+    {
+        return attr(type,
+                    std::string_view(reinterpret_cast<const char*>(&t),
+                                     sizeof(t)));
+    }
+
+    /** @brief Appends a NUL terminated string attribute */
+    MsgBuilder& str(uint16_t type, std::string_view s)
+    {
+        std::string tmp(s);
+        return attr(type, std::string_view(tmp.c_str(), tmp.size() + 1));
+    }
+
+    /** @brief Opens a nested attribute, closed by the matching endNest() */
+    MsgBuilder& nest(uint16_t type)
+    {
+        nests.push_back(buf.size());
+        rtattr hdr{};
+        hdr.rta_type = type;
+        return append(&hdr, sizeof(hdr), RTA_ALIGNTO);
+    }
+
+    MsgBuilder& endNest()
+    {
+        auto start = nests.back();
+        nests.pop_back();
+        auto len = static_cast<unsigned short>(buf.size() - start);
+        std::memcpy(buf.data() + start + offsetof(rtattr, rta_len), &len,
+                    sizeof(len));
+        return *this;
+    }
+
+    /** @brief Finishes the current message by filling in its length */
+    MsgBuilder& end()
+    {
+        auto len = static_cast<uint32_t>(buf.size() - msgStart);
+        std::memcpy(buf.data() + msgStart + offsetof(nlmsghdr, nlmsg_len),
+                    &len, sizeof(len));
+        return *this;
+    }
+
+    /** @brief Adds an NLMSG_DONE terminating a multipart dump */
+    MsgBuilder& done(uint32_t seq = 0, uint32_t pid = 0)
+    {
+        begin(NLMSG_DONE, NLM_F_MULTI, seq, pid);
+        return data(int{0}).end();
+    }
+
+    /** @brief All of the messages built so far */
+    std::string_view msgs() const noexcept
+    {
+        return buf;
+    }
+
+    /** @brief Payload of the last message, without its nlmsghdr */
+    std::string_view payload() const noexcept
+    {
+        return std::string_view(buf).substr(msgStart + NLMSG_HDRLEN);
+    }
+
+    void clear() noexcept
+    {
+        buf.clear();
+        nests.clear();
+        msgStart = 0;
+    }
+
+  private:
+    std::string buf;
+    std::vector<size_t> nests;
+    size_t msgStart = 0;
+
+    MsgBuilder& append(const void* data, size_t size, size_t align)
+    {
+        buf.append(reinterpret_cast<const char*>(data), size);
+        buf.resize((buf.size() + align - 1) & ~(align - 1), '\0');
+        return *this;
+    }
+};
+
+} // namespace phosphor::network::netlink
@@ -0,0 +1,264 @@
+#include "netlink.hpp"
+#include "netlink_capture.hpp"
+#include "network_manager.hpp"
+#include "rtnetlink_server.hpp"
+#include "statistics.hpp"
+#include "types.hpp"
+
+#include <getopt.h>
+#include <linux/rtnetlink.h>
+#include <systemd/sd-bus.h>
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/test/sdbus_mock.hpp>
+#include <stdplus/pinned.hpp>
+#include <stdplus/print.hpp>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+
+#include <gmock/gmock.h>
+
+constexpr char DEFAULT_OBJPATH[] = "/xyz/openbmc_project/network";
+
+namespace phosphor::network
+{
+
+/** @brief Mocked sd-bus which accepts everything the manager does, so the
+ *         replay never reaches a real bus. Queries to other daemons are
+ *         never answered.
+ */
+class ReplaySdBus : public testing::NiceMock<sdbusplus::SdBusMock>
+{
+  public:
+    ReplaySdBus()
+    {
+        using testing::_;
+        ON_CALL(*this, sd_bus_message_new_method_call(_, _, _, _, _, _))
+            .WillByDefault(testing::DoAll(testing::SetArgPointee<1>(nullptr),
+                                          testing::Return(0)));
+        ON_CALL(*this, sd_bus_call_async(_, _, _, _, _, _))
+            .WillByDefault(testing::DoAll(testing::SetArgPointee<1>(nullptr),
+                                          testing::Return(0)));
+    }
+};
+
+/** @brief Connects to the bus at the address, like a private dbus-daemon */
+static sdbusplus::bus_t connectBus(const std::string& address)
+{
+    sd_bus* b = nullptr;
+    if (sd_bus_new(&b) < 0 || sd_bus_set_address(b, address.c_str()) < 0 ||
+        sd_bus_set_bus_client(b, 1) < 0 || sd_bus_start(b) < 0)
+    {
+        sd_bus_unref(b);
+        throw std::runtime_error("Failed to connect to " + address);
+    }
+    return sdbusplus::bus_t(b, std::false_type{});
+}
+
+/** @brief Never reloads networkd, only counts the requests */
+class CountingExecutor : public DelayedExecutor
+{
+  public:
+    size_t scheduled = 0;
+
+    void schedule() override
+    {
+        scheduled++;
+    }
+
+    void setCallback(fu2::unique_function<void()>&&) override {}
+};
+
+/** @brief Manager fed from a capture. networkd is not around to answer
+ *         admin state queries, so every replayed link is treated as managed.
+ */
+class ReplayManager : public Manager
+{
+  public:
+    using Manager::Manager;
+
+    void replay(const nlmsghdr& hdr, std::string_view data)
+    {
+        if (hdr.nlmsg_type == RTM_NEWLINK)
+        {
+            auto msg = data;
+            unsigned idx = netlink::extractRtData<ifinfomsg>(msg).ifi_index;
+            if (!systemdNetworkdEnabled.contains(idx))
+            {
+                handleAdminState("managed", idx);
+            }
+        }
+        netlink::handler(*this, hdr, data);
+    }
+};
+
+static void usage(const char* argv0)
+{
+    stdplus::print(stderr,
+                   "Usage: {} [options] <capture.pcap>\n"
+                   "Options:\n"
+                   "    --full-speed | -f          Replay without the "
+                   "original delays.\n"
+                   "    --conf-dir=<dir> | -c <dir> Network configuration "
+                   "directory, a\n"
+                   "                               temporary one by default.\n"
+                   "    --bus=<address> | -b <addr> Publish on the D-Bus at "
+                   "the address,\n"
+                   "                               a mocked bus by default.\n"
+                   "    --system-bus | -s          Publish on the system bus "
+                   "and talk to\n"
+                   "                               the daemons there.\n"
+                   "    --help | -h                Print this menu.\n",
+                   argv0);
+}
+
+int main(int argc, char** argv)
+{
+    static const option options[] = {
+        {"full-speed", no_argument, nullptr, 'f'},
+        {"conf-dir", required_argument, nullptr, 'c'},
+        {"bus", required_argument, nullptr, 'b'},
+        {"system-bus", no_argument, nullptr, 's'},
+        {"help", no_argument, nullptr, 'h'},
+        {nullptr, 0, nullptr, 0},
+    };
+    bool fullSpeed = false, systemBus = false;
+    std::filesystem::path confDir;
+    std::string busAddress;
+    int opt;
+    while ((opt = getopt_long(argc, argv, "fc:b:sh", options, nullptr)) != -1)
+    {
+        switch (opt)
+        {
+            case 'f':
+                fullSpeed = true;
+                break;
+            case 'c':
+                confDir = optarg;
+                break;
+            case 'b':
+                busAddress = optarg;
+                break;
+            case 's':
+                systemBus = true;
+                break;
+            default:
+                usage(argv[0]);
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (optind + 1 != argc || (systemBus && !busAddress.empty()))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    // Never touch the real configuration unless asked to
+    bool tmpConf = confDir.empty();
+    if (tmpConf)
+    {
+        auto tmpl = (std::filesystem::temp_directory_path() /
+                     "netlink-replay.XXXXXX")
+                        .string();
+        if (mkdtemp(tmpl.data()) == nullptr)
+        {
+            throw std::system_error(errno, std::generic_category(), "mkdtemp");
+        }
+        confDir = tmpl;
+    }
+
+    netlink::CaptureReader reader(argv[optind]);
+    // Never touch the production bus unless asked to, the mapper would
+    // index the replayed objects and the mirrors would query the daemons
+    ReplaySdBus sdbus;
+    stdplus::Pinned bus = systemBus ? sdbusplus::bus::new_default()
+                          : busAddress.empty()
+                              ? sdbusplus::get_mocked_new(&sdbus)
+                              : connectBus(busAddress);
+    stdplus::Pinned<CountingExecutor> reload;
+    stdplus::Pinned<ReplayManager> manager(bus, reload, DEFAULT_OBJPATH,
+                                           confDir);
+
+    auto cb = [&](const nlmsghdr& hdr, std::string_view data) {
+        manager.get().replay(hdr, data);
+    };
+    size_t datagrams = 0, msgs = 0, errors = 0;
+    std::optional<std::chrono::nanoseconds> first;
+    auto start = std::chrono::steady_clock::now();
+    bool done = true;
+    while (auto datagram = reader.next())
+    {
+        if (!first)
+        {
+            first = datagram->time;
+        }
+        if (!fullSpeed)
+        {
+            std::this_thread::sleep_until(start + (datagram->time - *first));
+        }
+        datagrams++;
+        std::string_view data = datagram->data;
+        try
+        {
+            while (!data.empty())
+            {
+                netlink::detail::processMsg(data, done, cb);
+                msgs++;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            errors++;
+            done = true;
+            stdplus::print(stderr, "Bad datagram {}: {}\n", datagrams,
+                           e.what());
+        }
+    }
+    auto elapsed = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+
+    const auto& stats = stats::get();
+    stdplus::print(stdout,
+                   "Replayed {} datagrams, {} messages in {:.3f}s "
+                   "({:.0f} msg/s)\n",
+                   datagrams, msgs, elapsed, msgs / elapsed);
+    stdplus::print(stdout,
+                   "Interfaces: {}, reloads requested: {}, bad datagrams: "
+                   "{}, parse errors: {}, ignored events: {}\n",
+                   manager.get().interfaces.size(), reload.get().scheduled,
+                   errors, stats::load(stats.netlinkParseErrors),
+                   stats::load(stats.ignoredIntfEvents));
+
+    if (tmpConf)
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(confDir, ec);
+    }
+    return 0;
+}
+
+} // namespace phosphor::network
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        return phosphor::network::main(argc, argv);
+    }
+    catch (const std::exception& e)
+    {
+        stdplus::print(stderr, "FAILED: {}\n", e.what());
+        fflush(stderr);
+        return 1;
+    }
+}
@@ -1,8 +1,14 @@
+#include "config.h"
+
 #include "network_manager.hpp"
 
 #include "config_parser.hpp"
 #include "ipaddress.hpp"
+#include "netlink.hpp"
+#include "rtnetlink.hpp"
+#include "statistics.hpp"
 #include "system_queries.hpp"
+#include "tracepoints.hpp"
 #include "types.hpp"
 #include "util.hpp"
 
@@ -16,10 +22,11 @@
 #include <sdbusplus/message.hpp>
 #include <stdplus/numeric/str.hpp>
 #include <stdplus/pinned.hpp>
-#include <stdplus/print.hpp>
 #include <stdplus/str/cat.hpp>
 #include <xyz/openbmc_project/Common/error.hpp>
 
+#include <bitset>
+#include <chrono>
 #include <filesystem>
 #include <format>
 
@@ -44,7 +51,8 @@ Manager::Manager(stdplus::PinnedRef<sdbusplus::bus_t> bus,
                  stdplus::zstring_view objPath,
                  const std::filesystem::path& confDir) :
     ManagerIface(bus, objPath.c_str(), ManagerIface::action::defer_emit),
-    reload(reload), bus(bus), objPath(std::string(objPath)), confDir(confDir),
+    directVlan(DIRECT_VLAN), reload(reload), bus(bus),
+    objPath(std::string(objPath)), confDir(confDir),
     systemdNetworkdEnabledMatch(
         bus, enabledMatch,
         [man = stdplus::PinnedRef(*this)](sdbusplus::message_t& m) {
@@ -74,6 +82,25 @@ Manager::Manager(stdplus::PinnedRef<sdbusplus::bus_t> bus,
                 lg2::error("AdministrativeState match parsing failed: {ERROR}",
                            "ERROR", e);
             }
+        }),
+    serviceMirror(
+        bus,
+        [man = stdplus::PinnedRef(*this)](unsigned ifidx) {
+            auto& m = man.get();
+            if (auto it = m.links.find(ifidx);
+                it != m.links.end() && it->second.intf != nullptr)
+            {
+                it->second.intf->EthernetInterfaceIntf::nameservers(
+                    m.serviceMirror.getDNS(ifidx));
+            }
+        },
+        [man = stdplus::PinnedRef(*this)]() {
+            auto& m = man.get();
+            for (const auto& [_, intf] : m.interfaces)
+            {
+                intf->EthernetInterfaceIntf::ntpServers(
+                    m.serviceMirror.getNTP());
+            }
         })
 {
     reload.get().setCallback([self = stdplus::PinnedRef(*this)]() {
@@ -92,16 +119,26 @@ Manager::Manager(stdplus::PinnedRef<sdbusplus::bus_t> bus,
         self.get().reloadPreHooks.clear();
         try
         {
+            stats::add(stats::get().reloads);
+            auto start = stats::Clock::now();
+            NETWORKD_TRACE(reload_start);
             self.get()
                 .bus.get()
                 .new_method_call("org.freedesktop.network1",
                                  "/org/freedesktop/network1",
                                  "org.freedesktop.network1.Manager", "Reload")
                 .call();
+            auto latency = stats::Clock::now() - start;
+            stats::get().reloadLatency.record(latency);
+            NETWORKD_TRACE(
+                reload_end, 1,
+                std::chrono::duration_cast<std::chrono::microseconds>(latency)
+                    .count());
             lg2::info("Reloaded systemd-networkd");
         }
         catch (const sdbusplus::exception_t& ex)
         {
+            NETWORKD_TRACE(reload_end, 0, 0);
             lg2::error("Failed to reload configuration: {ERROR}", "ERROR", ex);
             self.get().reloadPostHooks.clear();
         }
@@ -119,70 +156,202 @@ Manager::Manager(stdplus::PinnedRef<sdbusplus::bus_t> bus,
         }
         self.get().reloadPostHooks.clear();
     });
-    std::vector<
-        std::tuple<int32_t, std::string, sdbusplus::message::object_path>>
-        links;
+    discoverNetworkdLinks();
+    serviceMirror.refreshNTP(startup.begin("timesyncd"));
+
+    std::filesystem::create_directories(confDir);
+    auto preload = startup.begin("config");
+    preloadConfigs();
+    preload.done();
+
+    systemConf = std::make_unique<phosphor::network::SystemConfiguration>(
+        bus, (this->objPath / "config").str, startup.begin("hostnamed"));
+    diagnostics = std::make_unique<Diagnostics>(
+        bus, (this->objPath / "diagnostics").str);
+    startup.onReady([man = stdplus::PinnedRef(*this)]() {
+        auto& m = man.get();
+        m.preloadedConfigs.clear();
+        m.diagnostics->startupComplete(m.startup);
+    });
+}
+
+void Manager::discoverNetworkdLinks()
+{
     try
     {
-        auto rsp = bus.get()
-                       .new_method_call("org.freedesktop.network1",
-                                        "/org/freedesktop/network1",
-                                        "org.freedesktop.network1.Manager",
-                                        "ListLinks")
-                       .call();
-        rsp.read(links);
+        listLinksCall.emplace(
+            bus.get()
+                .new_method_call("org.freedesktop.network1",
+                                 "/org/freedesktop/network1",
+                                 "org.freedesktop.network1.Manager",
+                                 "ListLinks")
+                .call_async([man = stdplus::PinnedRef(*this),
+                             ticket = startup.begin("networkd")](
+                                sdbusplus::message_t& m) mutable {
+                    auto done = std::move(ticket);
+                    if (m.is_method_error())
+                    {
+                        // Any failures are systemd-network not being ready
+                        return;
+                    }
+                    std::vector<std::tuple<int32_t, std::string,
+                                           sdbusplus::message::object_path>>
+                        links;
+                    try
+                    {
+                        m.read(links);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        lg2::error("Failed to parse networkd links: {ERROR}",
+                                   "ERROR", e);
+                        return;
+                    }
+                    for (const auto& link : links)
+                    {
+                        man.get().queryAdminState(
+                            std::get<0>(link),
+                            man.get().startup.begin("networkd"));
+                    }
+                }));
     }
-    catch (const sdbusplus::exception::SdBusError& e)
+    catch (const sdbusplus::exception_t& e)
     {
         // Any failures are systemd-network not being ready
     }
-    for (const auto& link : links)
+}
+
+void Manager::queryAdminState(unsigned ifidx, Startup::Ticket&& ticket)
+{
+    stdplus::ToStrHandle<stdplus::IntToStr<10, unsigned>> tsh;
+    auto obj =
+        stdplus::strCat("/org/freedesktop/network1/link/_3"sv, tsh(ifidx));
+    try
     {
-        unsigned ifidx = std::get<0>(link);
-        stdplus::ToStrHandle<stdplus::IntToStr<10, unsigned>> tsh;
-        auto obj =
-            stdplus::strCat("/org/freedesktop/network1/link/_3"sv, tsh(ifidx));
         auto req =
             bus.get().new_method_call("org.freedesktop.network1", obj.c_str(),
                                       "org.freedesktop.DBus.Properties", "Get");
         req.append("org.freedesktop.network1.Link", "AdministrativeState");
-        auto rsp = req.call();
-        std::variant<std::string> val;
-        rsp.read(val);
-        handleAdminState(std::get<std::string>(val), ifidx);
+        adminStateCalls.insert_or_assign(
+            ifidx, req.call_async([man = stdplus::PinnedRef(*this), ifidx,
+                                   ticket = std::move(ticket)](
+                                      sdbusplus::message_t& m) mutable {
+                auto done = std::move(ticket);
+                if (m.is_method_error())
+                {
+                    lg2::error("Failed to get AdministrativeState of "
+                               "{NET_IDX}: {ERROR}",
+                               "NET_IDX", ifidx, "ERROR",
+                               m.get_error()->message);
+                    return;
+                }
+                try
+                {
+                    std::variant<std::string> val;
+                    m.read(val);
+                    man.get().handleAdminState(std::get<std::string>(val),
+                                               ifidx);
+                }
+                catch (const std::exception& e)
+                {
+                    lg2::error("Failed to parse AdministrativeState of "
+                               "{NET_IDX}: {ERROR}",
+                               "NET_IDX", ifidx, "ERROR", e);
+                }
+            }));
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        lg2::error("Failed to query AdministrativeState of {NET_IDX}: {ERROR}",
+                   "NET_IDX", ifidx, "ERROR", e);
     }
+}
 
-    std::filesystem::create_directories(confDir);
-    systemConf = std::make_unique<phosphor::network::SystemConfiguration>(
-        bus, (this->objPath / "config").str);
+void Manager::preloadConfigs()
+{
+    std::error_code ec;
+    for (const auto& dirent : std::filesystem::directory_iterator(confDir, ec))
+    {
+        auto filename = dirent.path().filename();
+        std::string_view name = filename.native();
+        if (!name.starts_with("00-bmc-"sv) || !name.ends_with(".network"sv))
+        {
+            continue;
+        }
+        name.remove_prefix("00-bmc-"sv.size());
+        name.remove_suffix(".network"sv.size());
+        auto mtime = dirent.last_write_time(ec);
+        if (ec)
+        {
+            continue;
+        }
+        preloadedConfigs.insert_or_assign(
+            std::string(name),
+            PreloadedConfig{config::Parser(dirent.path()), mtime});
+    }
+}
+
+config::Parser Manager::loadConfig(std::string_view intf)
+{
+    auto path = config::pathForIntfConf(confDir, intf);
+    if (auto it = preloadedConfigs.find(intf); it != preloadedConfigs.end())
+    {
+        auto preloaded = std::move(it->second);
+        preloadedConfigs.erase(it);
+        std::error_code ec;
+        if (std::filesystem::last_write_time(path, ec) == preloaded.mtime &&
+            !ec)
+        {
+            return std::move(preloaded.parser);
+        }
+    }
+    return config::Parser(path);
 }
 
-void Manager::createInterface(const AllIntfInfo& info, bool enabled)
+/** @brief Drops the state held for a link once its interface holds it */
+static void releaseState(AllIntfInfo& info)
 {
+    info.defgw4.reset();
+    info.defgw6.reset();
+    info.addrs = {};
+    info.staticNeighs = {};
+}
+
+void Manager::createInterface(Link& link, bool enabled)
+{
+    const auto& info = link.info;
+    NETWORKD_TRACE(create_interface, info.intf.idx);
     if (ignoredIntf.find(info.intf.idx) != ignoredIntf.end())
     {
         return;
     }
-    if (auto it = interfacesByIdx.find(info.intf.idx);
-        it != interfacesByIdx.end())
+    if (link.intf != nullptr)
     {
-        if (info.intf.name && *info.intf.name != it->second->interfaceName())
-        {
-            interfaces.erase(it->second->interfaceName());
-            interfacesByIdx.erase(it);
-        }
-        else
+        if (!info.intf.name || *info.intf.name == link.intf->interfaceName())
         {
-            it->second->updateInfo(info.intf);
+            link.intf->updateInfo(info.intf);
             return;
         }
+        renameInterface(link);
+        return;
     }
     else if (info.intf.name)
     {
-        auto it = interfaces.find(*info.intf.name);
+        // Created over D-Bus before the kernel assigned it an index
+        auto it = interfaces.find(info.intf.name->view());
         if (it != interfaces.end())
         {
-            it->second->updateInfo(info.intf);
+            link.intf = it->second.get();
+            link.intf->updateInfo(info.intf);
+            for (const auto& [_, addr] : info.addrs)
+            {
+                link.intf->addAddr(addr);
+            }
+            for (const auto& [_, neigh] : info.staticNeighs)
+            {
+                link.intf->addStaticNeigh(neigh);
+            }
+            releaseState(link.info);
             return;
         }
     }
@@ -192,20 +361,46 @@ void Manager::createInterface(const AllIntfInfo& info, bool enabled)
                    info.intf.idx);
         return;
     }
-    config::Parser config(config::pathForIntfConf(confDir, *info.intf.name));
+    auto publish = startup.begin("publication");
+    auto config = loadConfig(*info.intf.name);
     auto intf = std::make_unique<EthernetInterface>(
         bus, *this, info, objPath.str, config, enabled);
     intf->loadNameServers(config);
     intf->loadNTPServers(config);
-    auto ptr = intf.get();
-    interfaces.insert_or_assign(*info.intf.name, std::move(intf));
-    interfacesByIdx.insert_or_assign(info.intf.idx, ptr);
+    link.intf = intf.get();
+    interfaces.insert_or_assign(std::string(*info.intf.name), std::move(intf));
+    serviceMirror.refreshDNS(info.intf.idx, startup.begin("resolved"));
+    releaseState(link.info);
+}
+
+void Manager::renameInterface(Link& link)
+{
+    const auto& info = link.info.intf;
+    NETWORKD_TRACE(rename_interface, info.idx);
+    auto it = interfaces.find(link.intf->interfaceName());
+    auto old = std::move(it->second);
+    interfaces.erase(it);
+
+    // networkd applies the config of the new name, the rest carries over
+    auto config = loadConfig(*info.name);
+    auto intf = std::make_unique<EthernetInterface>(bus, info, objPath.str,
+                                                    config, *old);
+    lg2::info("Renamed interface {NET_INTF_OLD} to {NET_INTF}", "NET_INTF_OLD",
+              old->interfaceName(), "NET_INTF", *info.name);
+    link.intf = intf.get();
+    interfaces.insert_or_assign(std::string(*info.name), std::move(intf));
 }
 
 void Manager::addInterface(const InterfaceInfo& info)
 {
+    if (!(info.flags & IFF_UP))
+    {
+        // The kernel flushes the IPv4 routes of a downed link silently
+        routeTable.forget(info.idx);
+    }
     if (info.type != ARPHRD_ETHER)
     {
+        stats::add(stats::get().ignoredIntfEvents);
         ignoredIntf.emplace(info.idx);
         return;
     }
@@ -214,74 +409,68 @@ void Manager::addInterface(const InterfaceInfo& info)
         const auto& ignored = internal::getIgnoredInterfaces();
         if (ignored.find(*info.name) != ignored.end())
         {
-            static std::unordered_set<std::string> ignored;
+            static std::unordered_set<IfName> ignored;
             if (!ignored.contains(*info.name))
             {
                 ignored.emplace(*info.name);
                 lg2::info("Ignoring interface {NET_INTF}", "NET_INTF",
-                          *info.name);
+                          info.name->view());
             }
+            stats::add(stats::get().ignoredIntfEvents);
             ignoredIntf.emplace(info.idx);
             return;
         }
     }
 
-    auto infoIt = intfInfo.find(info.idx);
-    if (infoIt != intfInfo.end())
+    auto linkIt = links.find(info.idx);
+    if (linkIt != links.end())
     {
-        infoIt->second.intf = info;
+        linkIt->second.info.intf = info;
     }
     else
     {
-        infoIt = std::get<0>(intfInfo.emplace(info.idx, AllIntfInfo{info}));
+        linkIt = std::get<0>(
+            links.emplace(info.idx, Link{.info = AllIntfInfo{info}}));
     }
 
     if (auto it = systemdNetworkdEnabled.find(info.idx);
         it != systemdNetworkdEnabled.end())
     {
-        createInterface(infoIt->second, it->second);
+        createInterface(linkIt->second, it->second);
     }
 }
 
 void Manager::removeInterface(const InterfaceInfo& info)
 {
-    auto iit = interfacesByIdx.find(info.idx);
+    EthernetInterface* intf = nullptr;
+    if (auto it = links.find(info.idx); it != links.end())
+    {
+        intf = it->second.intf;
+        links.erase(it);
+    }
     auto nit = interfaces.end();
-    if (info.name)
+    if (intf != nullptr)
     {
-        nit = interfaces.find(*info.name);
-        if (nit != interfaces.end() && iit != interfacesByIdx.end() &&
-            nit->second.get() != iit->second)
-        {
-            stdplus::print(stderr, "Removed interface desync detected\n");
-            fflush(stderr);
-            std::abort();
-        }
+        nit = interfaces.find(intf->interfaceName());
     }
-    else if (iit != interfacesByIdx.end())
+    else if (info.name)
     {
-        for (nit = interfaces.begin(); nit != interfaces.end(); ++nit)
+        // Created over D-Bus, but never bound to the link
+        nit = interfaces.find(info.name->view());
+        if (nit != interfaces.end() && nit->second->getIfIdx() != 0)
         {
-            if (nit->second.get() == iit->second)
-            {
-                break;
-            }
+            nit = interfaces.end();
         }
     }
-
-    if (iit != interfacesByIdx.end())
-    {
-        interfacesByIdx.erase(iit);
-    }
-    else
-    {
-        ignoredIntf.erase(info.idx);
-    }
     if (nit != interfaces.end())
     {
         interfaces.erase(nit);
     }
-    intfInfo.erase(info.idx);
+    ignoredIntf.erase(info.idx);
+    serviceMirror.forgetLink(info.idx);
+    applyTracker.forget(info.idx);
+    neighborTable.forget(info.idx);
+    routeTable.forget(info.idx);
 }
 
 void Manager::addAddress(const AddressInfo& info)
@@ -290,16 +479,23 @@ void Manager::addAddress(const AddressInfo& info)
     {
         return;
     }
-    if (auto it = intfInfo.find(info.ifidx); it != intfInfo.end())
+    applyTracker.confirm(info.ifidx, info.ifaddr);
+    if (auto it = links.find(info.ifidx); it != links.end())
     {
-        it->second.addrs.insert_or_assign(info.ifaddr, info);
-        if (auto it = interfacesByIdx.find(info.ifidx);
-            it != interfacesByIdx.end())
+        if (it->second.intf != nullptr)
         {
-            it->second->addAddr(info);
+            it->second.intf->addAddr(info);
+        }
+        else
+        {
+            it->second.info.addrs.insert_or_assign(info.ifaddr, info);
         }
     }
-    else if (!ignoredIntf.contains(info.ifidx))
+    else if (ignoredIntf.contains(info.ifidx))
+    {
+        stats::add(stats::get().ignoredIntfEvents);
+    }
+    else
     {
         throw std::runtime_error(
             std::format("Interface `{}` not found for addr", info.ifidx));
@@ -308,32 +504,42 @@ void Manager::addAddress(const AddressInfo& info)
 
 void Manager::removeAddress(const AddressInfo& info)
 {
-    if (auto it = interfacesByIdx.find(info.ifidx); it != interfacesByIdx.end())
+    if (auto it = links.find(info.ifidx); it != links.end())
     {
-        it->second->addrs.erase(info.ifaddr);
-        if (auto it = intfInfo.find(info.ifidx); it != intfInfo.end())
+        if (it->second.intf != nullptr)
+        {
+            it->second.intf->addrs.erase(info.ifaddr);
+        }
+        else
         {
-            it->second.addrs.erase(info.ifaddr);
+            it->second.info.addrs.erase(info.ifaddr);
         }
     }
 }
 
 void Manager::addNeighbor(const NeighborInfo& info)
 {
+    neighborTable.update(info);
     if (!(info.state & NUD_PERMANENT) || !info.addr)
     {
         return;
     }
-    if (auto it = intfInfo.find(info.ifidx); it != intfInfo.end())
+    if (auto it = links.find(info.ifidx); it != links.end())
     {
-        it->second.staticNeighs.insert_or_assign(*info.addr, info);
-        if (auto it = interfacesByIdx.find(info.ifidx);
-            it != interfacesByIdx.end())
+        if (it->second.intf != nullptr)
         {
-            it->second->addStaticNeigh(info);
+            it->second.intf->addStaticNeigh(info);
+        }
+        else
+        {
+            it->second.info.staticNeighs.insert_or_assign(*info.addr, info);
         }
     }
-    else if (!ignoredIntf.contains(info.ifidx))
+    else if (ignoredIntf.contains(info.ifidx))
+    {
+        stats::add(stats::get().ignoredIntfEvents);
+    }
+    else
     {
         throw std::runtime_error(
             std::format("Interface `{}` not found for neigh", info.ifidx));
@@ -342,61 +548,77 @@ void Manager::addNeighbor(const NeighborInfo& info)
 
 void Manager::removeNeighbor(const NeighborInfo& info)
 {
+    neighborTable.remove(info);
     if (!info.addr)
     {
         return;
     }
-    if (auto it = intfInfo.find(info.ifidx); it != intfInfo.end())
+    if (auto it = links.find(info.ifidx); it != links.end())
     {
-        it->second.staticNeighs.erase(*info.addr);
-        if (auto it = interfacesByIdx.find(info.ifidx);
-            it != interfacesByIdx.end())
+        if (it->second.intf != nullptr)
+        {
+            it->second.intf->staticNeighbors.erase(*info.addr);
+        }
+        else
         {
-            it->second->staticNeighbors.erase(*info.addr);
+            it->second.info.staticNeighs.erase(*info.addr);
         }
     }
 }
 
+void Manager::addRoute(const RouteInfo& info)
+{
+    routeTable.add(info);
+}
+
+void Manager::removeRoute(const RouteInfo& info)
+{
+    routeTable.remove(info);
+}
+
 void Manager::addDefGw(unsigned ifidx, stdplus::InAnyAddr addr)
 {
-    if (auto it = intfInfo.find(ifidx); it != intfInfo.end())
+    applyTracker.confirm(ifidx, addr);
+    if (auto it = links.find(ifidx); it != links.end())
     {
+        auto intf = it->second.intf;
+        auto& info = it->second.info;
         std::visit(
             [&](auto addr) {
                 if constexpr (std::is_same_v<stdplus::In4Addr, decltype(addr)>)
                 {
-                    it->second.defgw4.emplace(addr);
+                    if (intf != nullptr)
+                    {
+                        intf->EthernetInterfaceIntf::defaultGateway(
+                            stdplus::toStr(addr));
+                    }
+                    else
+                    {
+                        info.defgw4.emplace(addr);
+                    }
                 }
                 else
                 {
                     static_assert(
                         std::is_same_v<stdplus::In6Addr, decltype(addr)>);
-                    it->second.defgw6.emplace(addr);
-                }
-            },
-            addr);
-        if (auto it = interfacesByIdx.find(ifidx); it != interfacesByIdx.end())
-        {
-            std::visit(
-                [&](auto addr) {
-                    if constexpr (std::is_same_v<stdplus::In4Addr,
-                                                 decltype(addr)>)
+                    if (intf != nullptr)
                     {
-                        it->second->EthernetInterfaceIntf::defaultGateway(
+                        intf->EthernetInterfaceIntf::defaultGateway6(
                             stdplus::toStr(addr));
                     }
                     else
                     {
-                        static_assert(
-                            std::is_same_v<stdplus::In6Addr, decltype(addr)>);
-                        it->second->EthernetInterfaceIntf::defaultGateway6(
-                            stdplus::toStr(addr));
+                        info.defgw6.emplace(addr);
                     }
-                },
-                addr);
-        }
+                }
+            },
+            addr);
+    }
+    else if (ignoredIntf.contains(ifidx))
+    {
+        stats::add(stats::get().ignoredIntfEvents);
     }
-    else if (!ignoredIntf.contains(ifidx))
+    else
     {
         lg2::error("Interface {NET_IDX} not found for gw", "NET_IDX", ifidx);
     }
@@ -404,59 +626,93 @@ void Manager::addDefGw(unsigned ifidx, stdplus::InAnyAddr addr)
 
 void Manager::removeDefGw(unsigned ifidx, stdplus::InAnyAddr addr)
 {
-    if (auto it = intfInfo.find(ifidx); it != intfInfo.end())
+    if (auto it = links.find(ifidx); it != links.end())
     {
+        auto intf = it->second.intf;
+        auto& info = it->second.info;
         std::visit(
             [&](auto addr) {
                 if constexpr (std::is_same_v<stdplus::In4Addr, decltype(addr)>)
                 {
-                    if (it->second.defgw4 == addr)
+                    stdplus::ToStrHandle<stdplus::ToStr<stdplus::In4Addr>> tsh;
+                    if (intf != nullptr && intf->defaultGateway() == tsh(addr))
+                    {
+                        intf->EthernetInterfaceIntf::defaultGateway("");
+                    }
+                    else if (info.defgw4 == addr)
                     {
-                        it->second.defgw4.reset();
+                        info.defgw4.reset();
                     }
                 }
                 else
                 {
                     static_assert(
                         std::is_same_v<stdplus::In6Addr, decltype(addr)>);
-                    if (it->second.defgw6 == addr)
+                    stdplus::ToStrHandle<stdplus::ToStr<stdplus::In6Addr>> tsh;
+                    if (intf != nullptr &&
+                        intf->defaultGateway6() == tsh(addr))
                     {
-                        it->second.defgw6.reset();
+                        intf->EthernetInterfaceIntf::defaultGateway6("");
+                    }
+                    else if (info.defgw6 == addr)
+                    {
+                        info.defgw6.reset();
                     }
                 }
             },
             addr);
-        if (auto it = interfacesByIdx.find(ifidx); it != interfacesByIdx.end())
+    }
+}
+
+/** @brief Expands inclusive VLAN ID ranges into sorted, unique IDs */
+static std::vector<uint16_t>
+    vlanIds(const std::vector<std::tuple<uint32_t, uint32_t>>& ranges)
+{
+    if (ranges.empty())
+    {
+        lg2::error("No VLAN ID range given");
+        elog<InvalidArgument>(Argument::ARGUMENT_NAME("Ranges"),
+                              Argument::ARGUMENT_VALUE("[]"));
+    }
+    std::bitset<4095> set;
+    for (const auto& [first, last] : ranges)
+    {
+        if (first == 0 || first > last || last >= 4095)
         {
-            std::visit(
-                [&](auto addr) {
-                    if constexpr (std::is_same_v<stdplus::In4Addr,
-                                                 decltype(addr)>)
-                    {
-                        stdplus::ToStrHandle<stdplus::ToStr<stdplus::In4Addr>>
-                            tsh;
-                        if (it->second->defaultGateway() == tsh(addr))
-                        {
-                            it->second->EthernetInterfaceIntf::defaultGateway(
-                                "");
-                        }
-                    }
-                    else
-                    {
-                        static_assert(
-                            std::is_same_v<stdplus::In6Addr, decltype(addr)>);
-                        stdplus::ToStrHandle<stdplus::ToStr<stdplus::In6Addr>>
-                            tsh;
-                        if (it->second->defaultGateway6() == tsh(addr))
-                        {
-                            it->second->EthernetInterfaceIntf::defaultGateway6(
-                                "");
-                        }
-                    }
-                },
-                addr);
+            lg2::error("VLAN ID range {NET_VLAN}-{NET_VLAN_LAST} is not valid",
+                       "NET_VLAN", first, "NET_VLAN_LAST", last);
+            elog<InvalidArgument>(
+                Argument::ARGUMENT_NAME("VLANId"),
+                Argument::ARGUMENT_VALUE(
+                    std::format("{}-{}", first, last).c_str()));
+        }
+        for (auto id = first; id <= last; ++id)
+        {
+            set.set(id);
+        }
+    }
+    std::vector<uint16_t> ret;
+    ret.reserve(set.count());
+    for (uint16_t id = 1; id < set.size(); ++id)
+    {
+        if (set.test(id))
+        {
+            ret.push_back(id);
         }
     }
+    return ret;
+}
+
+EthernetInterface& Manager::findInterface(const std::string& interfaceName)
+{
+    auto it = interfaces.find(interfaceName);
+    if (it == interfaces.end())
+    {
+        using ResourceErr =
+            phosphor::logging::xyz::openbmc_project::Common::ResourceNotFound;
+        elog<ResourceNotFound>(ResourceErr::RESOURCE(interfaceName.c_str()));
+    }
+    return *it->second;
 }
 
 ObjectPath Manager::vlan(std::string interfaceName, uint32_t id)
@@ -468,15 +724,170 @@ ObjectPath Manager::vlan(std::string interfaceName, uint32_t id)
             Argument::ARGUMENT_NAME("VLANId"),
             Argument::ARGUMENT_VALUE(std::to_string(id).c_str()));
     }
+    return findInterface(interfaceName).createVLAN(id);
+}
 
-    auto it = interfaces.find(interfaceName);
-    if (it == interfaces.end())
+std::vector<ObjectPath>
+    Manager::createVLANs(std::string interfaceName,
+                         std::vector<std::tuple<uint32_t, uint32_t>> ranges)
+{
+    auto ids = vlanIds(ranges);
+    return findInterface(interfaceName).createVLANs(ids);
+}
+
+void Manager::deleteVLANs(std::string interfaceName,
+                          std::vector<std::tuple<uint32_t, uint32_t>> ranges)
+{
+    auto ids = vlanIds(ranges);
+    findInterface(interfaceName).deleteVLANs(ids);
+}
+
+std::tuple<std::vector<std::tuple<std::string, std::string, std::string,
+                                  std::string, uint64_t>>,
+           uint32_t>
+    Manager::query(std::string interfaceName, uint32_t start, uint32_t count)
+{
+    std::optional<unsigned> ifidx;
+    if (!interfaceName.empty())
+    {
+        ifidx = findInterface(interfaceName).getIfIdx();
+    }
+
+    if (!neighborTable.enabled())
+    {
+        neighborTable.enable();
+        try
+        {
+            netlink::performRequest(
+                NETLINK_ROUTE, RTM_GETNEIGH, NLM_F_DUMP, ndmsg{},
+                [&](const nlmsghdr& hdr, std::string_view data) {
+                    if (hdr.nlmsg_type == RTM_NEWNEIGH)
+                    {
+                        neighborTable.update(netlink::neighFromRtm(data));
+                    }
+                });
+        }
+        catch (const std::exception& e)
+        {
+            lg2::error("Failed to dump neighbors: {ERROR}", "ERROR", e);
+            neighborTable.disable();
+            elog<InternalFailure>();
+        }
+    }
+
+    // Only the neighbors of known links are listed, the others are counted
+    // neither in the page nor in the total
+    std::vector<std::tuple<std::string, std::string, std::string, std::string,
+                           uint64_t>>
+        neighbors;
+    uint32_t total = 0;
+    auto now = stats::Clock::now();
+    auto [first, last] = neighborTable.range(ifidx);
+    for (auto it = first; it != last; ++it)
+    {
+        const auto& [key, entry] = *it;
+        auto lit = links.find(key.ifidx);
+        if (lit == links.end() || !lit->second.info.intf.name)
+        {
+            continue;
+        }
+        if (total++ < start || neighbors.size() >= count)
+        {
+            continue;
+        }
+        std::string mac;
+        if (entry.mac != stdplus::EtherAddr{})
+        {
+            mac = stdplus::toStr(entry.mac);
+        }
+        neighbors.emplace_back(
+            std::string(lit->second.info.intf.name->view()),
+            stdplus::toStr(key.addr), std::move(mac),
+            std::string(neighStateStr(entry.state)),
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                now - entry.updated)
+                .count());
+    }
+    return {std::move(neighbors), total};
+}
+
+std::tuple<std::string, std::string, std::string>
+    Manager::lookup(std::string destination)
+{
+    std::optional<stdplus::InAnyAddr> dst;
+    try
+    {
+        dst.emplace(stdplus::fromStr<stdplus::InAnyAddr>(destination));
+    }
+    catch (const std::exception& e)
+    {
+        lg2::error("Not a valid IP address {NET_IP}: {ERROR}", "NET_IP",
+                   destination, "ERROR", e);
+        elog<InvalidArgument>(Argument::ARGUMENT_NAME("Destination"),
+                              Argument::ARGUMENT_VALUE(destination.c_str()));
+    }
+
+    auto route = routeTable.lookup(*dst);
+    if (route == nullptr || route->nexthops.empty())
     {
         using ResourceErr =
             phosphor::logging::xyz::openbmc_project::Common::ResourceNotFound;
-        elog<ResourceNotFound>(ResourceErr::RESOURCE(interfaceName.c_str()));
+        elog<ResourceNotFound>(ResourceErr::RESOURCE(destination.c_str()));
     }
-    return it->second->createVLAN(id);
+    // Multipath routes hash flows over their nexthops, report the first
+    const auto& nh = route->nexthops.front();
+
+    std::string name;
+    std::optional<stdplus::InAnyAddr> src = route->prefsrc;
+    auto onLink = nh.gateway.value_or(*dst);
+    auto pickSrc = [&](const stdplus::SubnetAny& ifaddr) {
+        auto addr = ifaddr.getAddr();
+        if (addr.index() != dst->index())
+        {
+            return;
+        }
+        if (!src || ifaddr.contains(onLink))
+        {
+            src = addr;
+        }
+    };
+    if (auto it = links.find(nh.oif); it != links.end())
+    {
+        const auto& link = it->second;
+        if (link.info.intf.name)
+        {
+            name = link.info.intf.name->view();
+        }
+        if (!route->prefsrc)
+        {
+            if (link.intf != nullptr)
+            {
+                for (const auto& [ifaddr, _] : link.intf->addrs)
+                {
+                    pickSrc(ifaddr);
+                }
+            }
+            else
+            {
+                for (const auto& [ifaddr, _] : link.info.addrs)
+                {
+                    pickSrc(ifaddr);
+                }
+            }
+        }
+    }
+    if (name.empty())
+    {
+        // Links we don't manage, like the loopback
+        char buf[IF_NAMESIZE];
+        if (if_indextoname(nh.oif, buf) != nullptr)
+        {
+            name = buf;
+        }
+    }
+
+    return {std::move(name), nh.gateway ? stdplus::toStr(*nh.gateway) : "",
+            src ? stdplus::toStr(*src) : ""};
 }
 
 void Manager::reset()
@@ -486,6 +897,7 @@ void Manager::reset()
         std::error_code ec;
         std::filesystem::remove(dirent.path(), ec);
     }
+    preloadedConfigs.clear();
     lg2::info("Network data purged.");
 }
 
@@ -508,7 +920,7 @@ void Manager::handleAdminState(std::string_view state, unsigned ifidx)
     {
         bool managed = state != "unmanaged";
         systemdNetworkdEnabled.insert_or_assign(ifidx, managed);
-        if (auto it = intfInfo.find(ifidx); it != intfInfo.end())
+        if (auto it = links.find(ifidx); it != links.end())
         {
             createInterface(it->second, managed);
         }
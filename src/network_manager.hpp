@@ -1,14 +1,24 @@
 #pragma once
+#include "apply_tracker.hpp"
+#include "config_parser.hpp"
 #include "dhcp_configuration.hpp"
+#include "diagnostics.hpp"
 #include "ethernet_interface.hpp"
+#include "neighbor_table.hpp"
+#include "route_table.hpp"
+#include "service_mirror.hpp"
+#include "startup.hpp"
 #include "system_configuration.hpp"
 #include "types.hpp"
+#include "xyz/openbmc_project/Network/Neighbor/Dynamic/server.hpp"
+#include "xyz/openbmc_project/Network/Route/Table/server.hpp"
 #include "xyz/openbmc_project/Network/VLAN/Create/server.hpp"
 
 #include <function2/function2.hpp>
 #include <sdbusplus/bus.hpp>
 #include <sdbusplus/bus/match.hpp>
 #include <sdbusplus/message/native_types.hpp>
+#include <sdbusplus/slot.hpp>
 #include <stdplus/pinned.hpp>
 #include <stdplus/str/maps.hpp>
 #include <stdplus/zstring_view.hpp>
@@ -16,8 +26,10 @@
 
 #include <filesystem>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <tuple>
 #include <vector>
 
 namespace phosphor
@@ -27,6 +39,8 @@ namespace network
 
 using ManagerIface = sdbusplus::server::object_t<
     sdbusplus::xyz::openbmc_project::Network::VLAN::server::Create,
+    sdbusplus::xyz::openbmc_project::Network::Neighbor::server::Dynamic,
+    sdbusplus::xyz::openbmc_project::Network::Route::server::Table,
     sdbusplus::xyz::openbmc_project::Common::server::FactoryReset>;
 
 /** @class Manager
@@ -50,6 +64,27 @@ class Manager : public ManagerIface
             const std::filesystem::path& confDir);
 
     ObjectPath vlan(std::string interfaceName, uint32_t id) override;
+    std::vector<ObjectPath> createVLANs(
+        std::string interfaceName,
+        std::vector<std::tuple<uint32_t, uint32_t>> ranges) override;
+    void deleteVLANs(
+        std::string interfaceName,
+        std::vector<std::tuple<uint32_t, uint32_t>> ranges) override;
+
+    /** @brief Pages through the neighbor cache, mirroring it from the
+     *         kernel on the first call
+     */
+    std::tuple<std::vector<std::tuple<std::string, std::string, std::string,
+                                      std::string, uint64_t>>,
+               uint32_t>
+        query(std::string interfaceName, uint32_t start,
+              uint32_t count) override;
+
+    /** @brief Resolves the egress interface, gateway and source address of
+     *         a destination from the mirrored routing tables
+     */
+    std::tuple<std::string, std::string, std::string>
+        lookup(std::string destination) override;
 
     /** @brief write the network conf file with the in-memory objects.
      */
@@ -67,6 +102,10 @@ class Manager : public ManagerIface
     void addNeighbor(const NeighborInfo& info);
     void removeNeighbor(const NeighborInfo& info);
 
+    /** @brief Add / remove a route of any table to the mirror */
+    void addRoute(const RouteInfo& info);
+    void removeRoute(const RouteInfo& info);
+
     /** @brief Add / remove default gateway for interface */
     void addDefGw(unsigned ifidx, stdplus::InAnyAddr addr);
     void removeDefGw(unsigned ifidx, stdplus::InAnyAddr addr);
@@ -94,6 +133,41 @@ class Manager : public ManagerIface
         return *dhcpConf;
     }
 
+    /** @brief gets the mirror of the resolved / timesyncd state.
+     */
+    inline const auto& getServiceMirror() const
+    {
+        return serviceMirror;
+    }
+
+    /** @brief gets the tracker of the changes waiting for the kernel.
+     */
+    inline auto& getApplyTracker()
+    {
+        return applyTracker;
+    }
+
+    /** @brief gets the mirror of the kernel neighbor cache.
+     */
+    inline const auto& getNeighborTable() const
+    {
+        return neighborTable;
+    }
+
+    /** @brief gets the mirror of the kernel routing tables.
+     */
+    inline const auto& getRouteTable() const
+    {
+        return routeTable;
+    }
+
+    /** @brief gets the tracker of the outstanding startup queries.
+     */
+    inline auto& getStartup()
+    {
+        return startup;
+    }
+
     /** @brief Arms a timer to tell systemd-network to reload all of the network
      * configurations
      */
@@ -102,12 +176,35 @@ class Manager : public ManagerIface
         reload.get().schedule();
     }
 
+    /** @brief Whether VLAN links are created and deleted over rtnetlink right
+     *         away, rather than by networkd on the next reload
+     */
+    bool directVlan;
+
+    /** @brief VLAN interfaces by the ifindex of their parent, maintained by
+     *         the VLAN objects themselves. Declared first as they unregister
+     *         on destruction.
+     */
+    std::unordered_map<unsigned, std::unordered_set<EthernetInterface*>>
+        vlanChildren;
+
     /** @brief Persistent map of EthernetInterface dbus objects and their names
      */
     stdplus::string_umap<std::unique_ptr<EthernetInterface>> interfaces;
-    std::unordered_map<unsigned, EthernetInterface*> interfacesByIdx;
     std::unordered_set<unsigned> ignoredIntf;
 
+    /** @class Link
+     *  @brief The one record kept for each kernel link. Its addresses,
+     *         neighbors and gateways are held in info only until the link is
+     *         published, after which its EthernetInterface is the only copy.
+     */
+    struct Link
+    {
+        AllIntfInfo info;
+        EthernetInterface* intf = nullptr;
+    };
+    std::unordered_map<unsigned, Link> links;
+
     /** @brief Adds a hook that runs immediately prior to reloading
      *
      *  @param[in] hook - The hook to execute before reloading
@@ -128,6 +225,11 @@ class Manager : public ManagerIface
     /** @brief Persistent sdbusplus DBus bus connection. */
     stdplus::PinnedRef<sdbusplus::bus_t> bus;
 
+    /** @brief Tracks the queries issued while starting up. Declared early so
+     *         it outlives the outstanding calls holding its tickets.
+     */
+    Startup startup;
+
     /** @brief BMC network reset - resets network configuration for BMC. */
     void reset() override;
 
@@ -140,16 +242,40 @@ class Manager : public ManagerIface
     /** @brief pointer to dhcp conf object. */
     std::unique_ptr<dhcp::Configuration> dhcpConf = nullptr;
 
+    /** @brief pointer to diagnostics object. */
+    std::unique_ptr<Diagnostics> diagnostics = nullptr;
+
     /** @brief Network Configuration directory. */
     std::filesystem::path confDir;
 
-    /** @brief Map of interface info for undiscovered interfaces */
-    std::unordered_map<unsigned, AllIntfInfo> intfInfo;
+    /** @brief Interface configs parsed ahead of interface discovery */
+    struct PreloadedConfig
+    {
+        config::Parser parser;
+        std::filesystem::file_time_type mtime;
+    };
+    stdplus::string_umap<PreloadedConfig> preloadedConfigs;
 
     /** @brief Map of enabled interfaces */
     std::unordered_map<unsigned, bool> systemdNetworkdEnabled;
     sdbusplus::bus::match_t systemdNetworkdEnabledMatch;
 
+    /** @brief Outstanding asynchronous networkd link queries */
+    std::optional<sdbusplus::slot_t> listLinksCall;
+    std::unordered_map<unsigned, sdbusplus::slot_t> adminStateCalls;
+
+    /** @brief Cached DNS and NTP state of resolved and timesyncd */
+    ServiceMirror serviceMirror;
+
+    /** @brief Changes requested over D-Bus not yet confirmed by the kernel */
+    ApplyTracker applyTracker;
+
+    /** @brief The kernel neighbor cache, once it has been queried */
+    NeighborTable neighborTable;
+
+    /** @brief The kernel routing tables */
+    RouteTable routeTable;
+
     /** @brief List of hooks to execute during the next reload */
     std::vector<fu2::unique_function<void()>> reloadPreHooks;
     std::vector<fu2::unique_function<void()>> reloadPostHooks;
@@ -157,8 +283,38 @@ class Manager : public ManagerIface
     /** @brief Handles the receipt of an administrative state string */
     void handleAdminState(std::string_view state, unsigned ifidx);
 
-    /** @brief Creates the interface in the maps */
-    void createInterface(const AllIntfInfo& info, bool enabled);
+    /** @brief Asynchronously lists the networkd links and queries all of
+     *         their administrative states in parallel. Later changes are
+     *         picked up by systemdNetworkdEnabledMatch.
+     */
+    void discoverNetworkdLinks();
+    void queryAdminState(unsigned ifidx, Startup::Ticket&& ticket = {});
+
+    /** @brief Parses all of the interface configs while the startup queries
+     *         are still in flight
+     */
+    void preloadConfigs();
+
+    /** @brief Gets the published interface by name, or raises
+     *         ResourceNotFound
+     */
+    EthernetInterface& findInterface(const std::string& interfaceName);
+
+    /** @brief Gets the config of the interface, preferring an unmodified
+     *         preloaded copy over re-reading it
+     */
+    config::Parser loadConfig(std::string_view intf);
+
+    /** @brief Publishes the link, or updates its interface if it already
+     *         is
+     */
+    void createInterface(Link& link, bool enabled);
+
+    /** @brief Moves the published interface of the link to its new name,
+     *         carrying its objects over rather than rebuilding them from
+     *         the kernel
+     */
+    void renameInterface(Link& link);
 };
 
 } // namespace network
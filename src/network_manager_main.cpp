@@ -5,21 +5,26 @@
 #endif
 #include "network_manager.hpp"
 #include "rtnetlink_server.hpp"
+#include "stall_monitor.hpp"
+#include "statistics.hpp"
 #include "types.hpp"
 
+#include <systemd/sd-daemon.h>
+
 #include <phosphor-logging/lg2.hpp>
 #include <sdbusplus/bus.hpp>
 #include <sdbusplus/server/manager.hpp>
 #include <sdeventplus/clock.hpp>
 #include <sdeventplus/event.hpp>
 #include <sdeventplus/source/signal.hpp>
-#include <sdeventplus/utility/sdbus.hpp>
 #include <sdeventplus/utility/timer.hpp>
 #include <stdplus/pinned.hpp>
 #include <stdplus/print.hpp>
 #include <stdplus/signal.hpp>
 
 #include <chrono>
+#include <cstdlib>
+#include <memory>
 
 constexpr char DEFAULT_OBJPATH[] = "/xyz/openbmc_project/network";
 
@@ -43,7 +48,10 @@ class TimerExecutor : public DelayedExecutor
 
     void setCallback(fu2::unique_function<void()>&& cb) override
     {
-        timer.set_callback([cb = std::move(cb)](Timer&) mutable { cb(); });
+        timer.set_callback([cb = std::move(cb)](Timer&) mutable {
+            stall::get().label("timer", "reload");
+            cb();
+        });
     }
 
   private:
@@ -63,20 +71,34 @@ int main()
     stdplus::signal::block(SIGTERM);
     sdeventplus::source::Signal(event, SIGTERM, termCb).set_floating(true);
 
-    stdplus::Pinned bus = sdbusplus::bus::new_default();
+    stats::CountingSdBus countingBus;
+    stdplus::Pinned bus = stats::newDefaultBus(countingBus);
     sdbusplus::server::manager_t objManager(bus, DEFAULT_OBJPATH);
 
     stdplus::Pinned<TimerExecutor> reload(event, std::chrono::seconds(3));
     stdplus::Pinned<Manager> manager(bus, reload, DEFAULT_OBJPATH,
                                      "/etc/systemd/network");
-    netlink::Server svr(event, manager);
+    // Records every netlink datagram for later replay when requested
+    std::unique_ptr<netlink::Capture> capture;
+    if (auto path = std::getenv("NETLINK_CAPTURE"); path != nullptr)
+    {
+        capture = std::make_unique<netlink::Capture>(path);
+        lg2::notice("Capturing netlink datagrams to {PATH}", "PATH", path);
+    }
+    netlink::Server svr(event, manager, capture.get());
 
 #ifdef SYNC_MAC_FROM_INVENTORY
     auto runtime = inventory::watch(bus, manager);
 #endif
 
+    auto& startup = manager.get().getStartup();
+    auto publish = startup.begin("publication");
     bus.request_name(DEFAULT_BUSNAME);
-    return sdeventplus::utility::loopWithBus(event, bus);
+    publish.done();
+
+    startup.onReady([]() { sd_notify(0, "READY=1"); });
+    startup.seal();
+    return stall::get().loop(event, bus);
 }
 
 } // namespace phosphor::network
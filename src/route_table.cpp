@@ -0,0 +1,300 @@
+#include "route_table.hpp"
+
+#include <linux/rtnetlink.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <utility>
+#include <variant>
+
+namespace phosphor
+{
+namespace network
+{
+
+using Bits = std::array<uint8_t, 16>;
+
+static Bits toBits(stdplus::InAnyAddr addr) noexcept
+{
+    Bits ret{};
+    std::visit([&](const auto& a) { std::memcpy(ret.data(), &a, sizeof(a)); },
+               addr);
+    return ret;
+}
+
+static uint8_t maxLen(stdplus::InAnyAddr addr) noexcept
+{
+    return std::holds_alternative<stdplus::In4Addr>(addr) ? 32 : 128;
+}
+
+static unsigned bitAt(const Bits& bits, uint8_t i) noexcept
+{
+    return (bits[i / 8] >> (7 - i % 8)) & 1;
+}
+
+/** @brief Number of leading bits a and b share, up to len */
+static uint8_t commonLen(const Bits& a, const Bits& b, uint8_t len) noexcept
+{
+    uint8_t ret = 0;
+    for (size_t i = 0; ret < len; ++i, ret += 8)
+    {
+        if (auto diff = a[i] ^ b[i]; diff != 0)
+        {
+            ret += std::countl_zero(static_cast<uint8_t>(diff));
+            break;
+        }
+    }
+    return std::min(ret, len);
+}
+
+/** @brief Clears all of the bits past len */
+static Bits masked(Bits bits, uint8_t len) noexcept
+{
+    for (size_t i = 0; i < bits.size(); ++i, len = len > 8 ? len - 8 : 0)
+    {
+        bits[i] &= len >= 8 ? 0xff : static_cast<uint8_t>(0xff00 >> len);
+    }
+    return bits;
+}
+
+void RouteTrie::add(const RouteInfo& route)
+{
+    auto len = route.dst.getPfx();
+    auto prefix = masked(toBits(route.dst.getAddr()), len);
+    auto* slot = &root;
+    while (*slot)
+    {
+        auto& node = *slot;
+        auto common = commonLen(node->prefix, prefix, std::min(node->len, len));
+        if (common == node->len)
+        {
+            if (common == len)
+            {
+                break;
+            }
+            slot = &node->child[bitAt(prefix, common)];
+            continue;
+        }
+        // The prefix diverges inside of the node, so it needs a parent
+        // at the point they part
+        auto parent = std::make_unique<Node>(Node{masked(prefix, common),
+                                                  common});
+        parent->child[bitAt(node->prefix, common)] = std::move(node);
+        node = std::move(parent);
+        if (common != len)
+        {
+            slot = &node->child[bitAt(prefix, common)];
+        }
+        break;
+    }
+    if (!*slot)
+    {
+        *slot = std::make_unique<Node>(Node{prefix, len});
+    }
+
+    auto& routes = (*slot)->routes;
+    auto it = std::lower_bound(routes.begin(), routes.end(), route.priority,
+                               [](const RouteInfo& r, uint32_t priority) {
+                                   return r.priority < priority;
+                               });
+    if (it != routes.end() && it->priority == route.priority)
+    {
+        *it = route;
+    }
+    else
+    {
+        routes.insert(it, route);
+        ++count;
+    }
+}
+
+/** @brief Drops a node left without routes, unless it still splits two
+ *         children
+ */
+static void compact(auto& slot)
+{
+    if (!slot->routes.empty() || (slot->child[0] && slot->child[1]))
+    {
+        return;
+    }
+    auto child = std::move(slot->child[slot->child[0] ? 0 : 1]);
+    slot = std::move(child);
+}
+
+bool RouteTrie::remove(std::unique_ptr<Node>& slot, const Bits& prefix,
+                       uint8_t len, uint32_t priority)
+{
+    if (!slot || slot->len > len ||
+        commonLen(slot->prefix, prefix, slot->len) != slot->len)
+    {
+        return false;
+    }
+    if (slot->len < len)
+    {
+        if (!remove(slot->child[bitAt(prefix, slot->len)], prefix, len,
+                    priority))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        auto& routes = slot->routes;
+        auto it = std::find_if(routes.begin(), routes.end(),
+                               [&](const RouteInfo& r) {
+                                   return r.priority == priority;
+                               });
+        if (it == routes.end())
+        {
+            return false;
+        }
+        routes.erase(it);
+    }
+    compact(slot);
+    return true;
+}
+
+void RouteTrie::remove(const RouteInfo& route)
+{
+    auto len = route.dst.getPfx();
+    if (remove(root, masked(toBits(route.dst.getAddr()), len), len,
+               route.priority))
+    {
+        --count;
+    }
+}
+
+size_t RouteTrie::forget(std::unique_ptr<Node>& slot, unsigned ifidx)
+{
+    if (!slot)
+    {
+        return 0;
+    }
+    size_t ret = forget(slot->child[0], ifidx) + forget(slot->child[1], ifidx);
+    ret += std::erase_if(slot->routes, [&](const RouteInfo& r) {
+        return !r.nexthops.empty() &&
+               std::all_of(r.nexthops.begin(), r.nexthops.end(),
+                           [&](const auto& nh) { return nh.oif == ifidx; });
+    });
+    compact(slot);
+    return ret;
+}
+
+void RouteTrie::forget(unsigned ifidx)
+{
+    count -= forget(root, ifidx);
+}
+
+const RouteInfo* RouteTrie::lookup(stdplus::InAnyAddr addr) const
+{
+    auto bits = toBits(addr);
+    auto max = maxLen(addr);
+    const RouteInfo* ret = nullptr;
+    for (auto node = root.get();
+         node != nullptr &&
+         commonLen(node->prefix, bits, node->len) == node->len;)
+    {
+        if (!node->routes.empty())
+        {
+            ret = &node->routes.front();
+        }
+        if (node->len >= max)
+        {
+            break;
+        }
+        node = node->child[bitAt(bits, node->len)].get();
+    }
+    return ret;
+}
+
+/** @brief Whether routes of the type can be resolved to an interface or
+ *         decide that there is no route. Broadcast, multicast and anycast
+ *         routes of the local table are not kept.
+ */
+static bool mirrored(uint8_t type) noexcept
+{
+    switch (type)
+    {
+        case RTN_UNICAST:
+        case RTN_LOCAL:
+        case RTN_BLACKHOLE:
+        case RTN_UNREACHABLE:
+        case RTN_PROHIBIT:
+        case RTN_THROW:
+            return true;
+    }
+    return false;
+}
+
+void RouteTable::add(const RouteInfo& route)
+{
+    if (mirrored(route.type))
+    {
+        tables[route.table][route.dst.getAddr().index()].add(route);
+    }
+}
+
+void RouteTable::remove(const RouteInfo& route)
+{
+    if (!mirrored(route.type))
+    {
+        return;
+    }
+    auto it = tables.find(route.table);
+    if (it == tables.end())
+    {
+        return;
+    }
+    auto& tries = it->second;
+    tries[route.dst.getAddr().index()].remove(route);
+    if (tries[0].size() == 0 && tries[1].size() == 0)
+    {
+        tables.erase(it);
+    }
+}
+
+void RouteTable::forget(unsigned ifidx)
+{
+    for (auto& [_, tries] : tables)
+    {
+        tries[0].forget(ifidx);
+        tries[1].forget(ifidx);
+    }
+}
+
+const RouteInfo* RouteTable::lookup(stdplus::InAnyAddr addr) const
+{
+    for (auto table : {RT_TABLE_LOCAL, RT_TABLE_MAIN, RT_TABLE_DEFAULT})
+    {
+        auto it = tables.find(table);
+        if (it == tables.end())
+        {
+            continue;
+        }
+        auto route = it->second[addr.index()].lookup(addr);
+        if (route == nullptr || route->type == RTN_THROW)
+        {
+            continue;
+        }
+        if (route->type != RTN_UNICAST && route->type != RTN_LOCAL)
+        {
+            return nullptr;
+        }
+        return route;
+    }
+    return nullptr;
+}
+
+size_t RouteTable::size() const noexcept
+{
+    size_t ret = 0;
+    for (const auto& [_, tries] : tables)
+    {
+        ret += tries[0].size() + tries[1].size();
+    }
+    return ret;
+}
+
+} // namespace network
+} // namespace phosphor
@@ -0,0 +1,96 @@
+#pragma once
+#include "types.hpp"
+
+#include <stdplus/net/addr/ip.hpp>
+#include <stdplus/net/addr/subnet.hpp>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace phosphor
+{
+namespace network
+{
+
+/** @class RouteTrie
+ *  @brief Longest prefix match trie over the routes of a single table and
+ *         address family.
+ *  @details Path compressed, so every node either holds routes or splits
+ *           the prefixes below it in two, and a table of N routes has fewer
+ *           than 2N nodes whatever the address length. The routes of a
+ *           prefix are kept in order of their priority, lowest first.
+ */
+class RouteTrie
+{
+  public:
+    /** @brief Adds the route, replacing the one of the same priority */
+    void add(const RouteInfo& route);
+
+    /** @brief Removes the route of the same prefix and priority */
+    void remove(const RouteInfo& route);
+
+    /** @brief Removes the routes leaving only through the interface */
+    void forget(unsigned ifidx);
+
+    /** @brief The preferred route of the longest prefix holding addr */
+    const RouteInfo* lookup(stdplus::InAnyAddr addr) const;
+
+    inline size_t size() const noexcept
+    {
+        return count;
+    }
+
+  private:
+    using Bits = std::array<uint8_t, 16>;
+
+    struct Node
+    {
+        Bits prefix;
+        uint8_t len;
+        std::array<std::unique_ptr<Node>, 2> child = {};
+        std::vector<RouteInfo> routes = {};
+    };
+
+    std::unique_ptr<Node> root;
+    size_t count = 0;
+
+    static bool remove(std::unique_ptr<Node>& slot, const Bits& prefix,
+                       uint8_t len, uint32_t priority);
+    static size_t forget(std::unique_ptr<Node>& slot, unsigned ifidx);
+};
+
+/** @class RouteTable
+ *  @brief Mirror of the kernel routing tables, kept from the route dump and
+ *         RTM_NEWROUTE / RTM_DELROUTE notifications.
+ */
+class RouteTable
+{
+  public:
+    void add(const RouteInfo& route);
+    void remove(const RouteInfo& route);
+
+    /** @brief Drops the routes of a removed or downed interface, which the
+     *         kernel flushes without notifying IPv4 listeners
+     */
+    void forget(unsigned ifidx);
+
+    /** @brief Resolves the route the kernel would use for addr, looking in
+     *         the local, main and default tables like the default policy
+     *         rules. Returns nothing if there is no route or it rejects
+     *         the traffic, like unreachable and blackhole routes do.
+     */
+    const RouteInfo* lookup(stdplus::InAnyAddr addr) const;
+
+    /** @brief Number of routes across all of the tables */
+    size_t size() const noexcept;
+
+  private:
+    /** @brief Keyed by table, then IPv4 and IPv6 */
+    std::unordered_map<uint32_t, std::array<RouteTrie, 2>> tables;
+};
+
+} // namespace network
+} // namespace phosphor
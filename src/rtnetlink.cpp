@@ -5,9 +5,15 @@
 
 #include <linux/rtnetlink.h>
 
+#include <algorithm>
+#include <format>
+#include <vector>
+
 namespace phosphor::network::netlink
 {
 
+using stdplus::raw::Aligned;
+
 using std::literals::string_view_literals::operator""sv;
 
 static void parseVlanInfo(InterfaceInfo& info, std::string_view msg)
@@ -38,7 +44,11 @@ static void parseLinkInfo(InterfaceInfo& info, std::string_view msg)
         {
             case IFLA_INFO_KIND:
                 data.remove_suffix(1);
-                info.kind.emplace(data);
+                // Only the kinds we act on need to be told apart
+                if (data.size() <= IfName::capacity())
+                {
+                    info.kind.emplace(data);
+                }
                 break;
             case IFLA_INFO_DATA:
                 submsg = data;
@@ -64,7 +74,8 @@ InterfaceInfo intfFromRtm(std::string_view msg)
         switch (hdr.rta_type)
         {
             case IFLA_IFNAME:
-                ret.name.emplace(data.begin(), data.end() - 1);
+                data.remove_suffix(1);
+                ret.name.emplace(data);
                 break;
             case IFLA_ADDRESS:
                 if (data.size() == sizeof(stdplus::EtherAddr))
@@ -131,6 +142,95 @@ std::optional<std::tuple<unsigned, stdplus::InAnyAddr>>
     return std::nullopt;
 }
 
+static std::vector<RouteInfo::NextHop> parseMultipath(uint8_t family,
+                                                      std::string_view msg)
+{
+    std::vector<RouteInfo::NextHop> ret;
+    while (!msg.empty())
+    {
+        const auto& nh = stdplus::raw::refFrom<rtnexthop, Aligned>(msg);
+        if (nh.rtnh_len < sizeof(nh) || msg.size() < nh.rtnh_len)
+        {
+            throw std::runtime_error(
+                std::format("Bad rtnexthop length: {}", nh.rtnh_len));
+        }
+        auto& hop = ret.emplace_back(RouteInfo::NextHop{
+            .oif = static_cast<unsigned>(nh.rtnh_ifindex),
+            .weight = static_cast<uint16_t>(nh.rtnh_hops + 1)});
+        auto attrs = msg.substr(RTNH_LENGTH(0), nh.rtnh_len - RTNH_LENGTH(0));
+        while (!attrs.empty())
+        {
+            auto [hdr, data] = extractRtAttr(attrs);
+            if (hdr.rta_type == RTA_GATEWAY)
+            {
+                hop.gateway.emplace(addrFromBuf(family, data));
+            }
+        }
+        msg.remove_prefix(std::min<size_t>(RTNH_ALIGN(nh.rtnh_len),
+                                           msg.size()));
+    }
+    return ret;
+}
+
+std::optional<RouteInfo> routeFromRtm(std::string_view msg)
+{
+    const auto& rtm = extractRtData<rtmsg>(msg);
+    if (rtm.rtm_family != AF_INET && rtm.rtm_family != AF_INET6)
+    {
+        return std::nullopt;
+    }
+
+    RouteInfo ret{.table = rtm.rtm_table,
+                  .protocol = rtm.rtm_protocol,
+                  .scope = rtm.rtm_scope,
+                  .type = rtm.rtm_type,
+                  .dst = stdplus::SubnetAny{
+                      rtm.rtm_family == AF_INET
+                          ? stdplus::InAnyAddr{stdplus::In4Addr{}}
+                          : stdplus::InAnyAddr{stdplus::In6Addr{}},
+                      rtm.rtm_dst_len}};
+    std::optional<stdplus::InAnyAddr> dst, gateway;
+    unsigned oif = 0;
+    while (!msg.empty())
+    {
+        auto [hdr, data] = extractRtAttr(msg);
+        switch (hdr.rta_type)
+        {
+            case RTA_TABLE:
+                ret.table = stdplus::raw::copyFromStrict<uint32_t>(data);
+                break;
+            case RTA_DST:
+                dst.emplace(addrFromBuf(rtm.rtm_family, data));
+                break;
+            case RTA_GATEWAY:
+                gateway.emplace(addrFromBuf(rtm.rtm_family, data));
+                break;
+            case RTA_OIF:
+                oif = stdplus::raw::copyFromStrict<uint32_t>(data);
+                break;
+            case RTA_PRIORITY:
+                ret.priority = stdplus::raw::copyFromStrict<uint32_t>(data);
+                break;
+            case RTA_PREFSRC:
+                ret.prefsrc.emplace(addrFromBuf(rtm.rtm_family, data));
+                break;
+            case RTA_MULTIPATH:
+                ret.nexthops = parseMultipath(rtm.rtm_family, data);
+                break;
+        }
+    }
+    if (dst)
+    {
+        ret.dst = stdplus::SubnetAny{*dst, rtm.rtm_dst_len};
+    }
+    if (ret.nexthops.empty() && (oif != 0 || gateway))
+    {
+        ret.nexthops.push_back(
+            RouteInfo::NextHop{.oif = oif, .gateway = gateway});
+    }
+    return ret;
+}
+
 AddressInfo addrFromRtm(std::string_view msg)
 {
     const auto& ifa = extractRtData<ifaddrmsg>(msg);
@@ -13,6 +13,12 @@ InterfaceInfo intfFromRtm(std::string_view msg);
 std::optional<std::tuple<unsigned, stdplus::InAnyAddr>>
     gatewayFromRtm(std::string_view msg);
 
+/** @brief Parses a route of any table, multipath routes included
+ *  @returns nothing for families other than IPv4 and IPv6, like the
+ *           multicast routing tables
+ */
+std::optional<RouteInfo> routeFromRtm(std::string_view msg);
+
 AddressInfo addrFromRtm(std::string_view msg);
 
 NeighborInfo neighFromRtm(std::string_view msg);
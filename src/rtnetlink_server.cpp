@@ -3,6 +3,9 @@
 #include "netlink.hpp"
 #include "network_manager.hpp"
 #include "rtnetlink.hpp"
+#include "stall_monitor.hpp"
+#include "statistics.hpp"
+#include "tracepoints.hpp"
 
 #include <linux/netlink.h>
 #include <linux/rtnetlink.h>
@@ -14,6 +17,8 @@
 namespace phosphor::network::netlink
 {
 
+using std::literals::string_view_literals::operator""sv;
+
 inline void rthandler(std::string_view data, auto&& cb)
 {
     auto ret = gatewayFromRtm(data);
@@ -41,40 +46,75 @@ static unsigned getIfIdx(const nlmsghdr& hdr, std::string_view data)
     throw std::runtime_error("Unknown nlmsg_type");
 }
 
-static void handler(Manager& m, const nlmsghdr& hdr, std::string_view data)
+void handler(Manager& m, const nlmsghdr& hdr, std::string_view data)
 {
+    stats::netlinkMsg(hdr.nlmsg_type);
     try
     {
         switch (hdr.nlmsg_type)
         {
             case RTM_NEWLINK:
-                m.addInterface(intfFromRtm(data));
+            {
+                auto info = intfFromRtm(data);
+                NETWORKD_TRACE(netlink_newlink, info.idx);
+                m.addInterface(info);
                 break;
+            }
             case RTM_DELLINK:
-                m.removeInterface(intfFromRtm(data));
+            {
+                auto info = intfFromRtm(data);
+                NETWORKD_TRACE(netlink_dellink, info.idx);
+                m.removeInterface(info);
                 break;
+            }
             case RTM_NEWROUTE:
                 rthandler(data, [&](auto ifidx, auto addr) {
+                    NETWORKD_TRACE(netlink_newroute, ifidx);
                     m.addDefGw(ifidx, addr);
                 });
+                if (auto route = routeFromRtm(data))
+                {
+                    m.addRoute(*route);
+                }
                 break;
             case RTM_DELROUTE:
                 rthandler(data, [&](auto ifidx, auto addr) {
+                    NETWORKD_TRACE(netlink_delroute, ifidx);
                     m.removeDefGw(ifidx, addr);
                 });
+                if (auto route = routeFromRtm(data))
+                {
+                    m.removeRoute(*route);
+                }
                 break;
             case RTM_NEWADDR:
-                m.addAddress(addrFromRtm(data));
+            {
+                auto info = addrFromRtm(data);
+                NETWORKD_TRACE(netlink_newaddr, info.ifidx);
+                m.addAddress(info);
                 break;
+            }
             case RTM_DELADDR:
-                m.removeAddress(addrFromRtm(data));
+            {
+                auto info = addrFromRtm(data);
+                NETWORKD_TRACE(netlink_deladdr, info.ifidx);
+                m.removeAddress(info);
                 break;
+            }
             case RTM_NEWNEIGH:
-                m.addNeighbor(neighFromRtm(data));
+            {
+                auto info = neighFromRtm(data);
+                NETWORKD_TRACE(netlink_newneigh, info.ifidx);
+                m.addNeighbor(info);
                 break;
+            }
             case RTM_DELNEIGH:
-                m.removeNeighbor(neighFromRtm(data));
+            {
+                auto info = neighFromRtm(data);
+                NETWORKD_TRACE(netlink_delneigh, info.ifidx);
+                m.removeNeighbor(info);
                 break;
+            }
         }
     }
     catch (const std::exception& e)
@@ -84,22 +124,54 @@ static void handler(Manager& m, const nlmsghdr& hdr, std::string_view data)
             if (m.ignoredIntf.contains(getIfIdx(hdr, data)))
             {
                 // We don't want to log errors for ignored interfaces
+                stats::add(stats::get().ignoredIntfEvents);
                 return;
             }
         }
         catch (...)
         {}
+        stats::add(stats::get().netlinkParseErrors);
         lg2::error("Failed handling netlink event: {ERROR}", "ERROR", e);
     }
 }
 
-static void eventHandler(Manager& m, sdeventplus::source::IO&, int fd, uint32_t)
+static void captureDatagram(Capture* capture, std::string_view datagram)
+{
+    if (capture == nullptr)
+    {
+        return;
+    }
+    try
+    {
+        capture->record(datagram);
+    }
+    catch (const std::exception& e)
+    {
+        lg2::error("Failed capturing netlink datagram: {ERROR}", "ERROR", e);
+    }
+}
+
+static void eventHandler(Manager& m, Capture* capture, sdeventplus::source::IO&,
+                         int fd, uint32_t)
 {
-    auto cb = [&](auto&&... args) {
-        return handler(m, std::forward<decltype(args)>(args)...);
+    // Attribute the dispatch to the slowest message type it handled
+    uint16_t slowestType = 0;
+    stall::Clock::duration slowest{};
+    auto cb = [&](const nlmsghdr& hdr, std::string_view data) {
+        auto start = stall::Clock::now();
+        handler(m, hdr, data);
+        if (auto d = stall::Clock::now() - start; d >= slowest)
+        {
+            slowest = d;
+            slowestType = hdr.nlmsg_type;
+        }
+    };
+    auto dgram = [&](std::string_view datagram) {
+        captureDatagram(capture, datagram);
     };
-    while (receive(fd, cb) > 0)
+    while (receive(fd, cb, dgram) > 0)
         ;
+    stall::get().label("netlink"sv, stats::netlinkTypeName(slowestType));
 }
 
 static stdplus::ManagedFd makeSock()
@@ -120,19 +192,31 @@ static stdplus::ManagedFd makeSock()
     return sock;
 }
 
-Server::Server(sdeventplus::Event& event, Manager& manager) :
+Server::Server(sdeventplus::Event& event, Manager& manager,
+               Capture* capture) :
     sock(makeSock()),
-    io(event, sock.get(), EPOLLIN | EPOLLET, [&](auto&&... args) {
-        return eventHandler(manager, std::forward<decltype(args)>(args)...);
-    })
+    io(event, sock.get(), EPOLLIN | EPOLLET,
+       [&manager, capture](auto&&... args) {
+           return eventHandler(manager, capture,
+                               std::forward<decltype(args)>(args)...);
+       })
 {
+    auto dump = manager.getStartup().begin("netlink");
     auto cb = [&](const nlmsghdr& hdr, std::string_view data) {
         handler(manager, hdr, data);
     };
-    performRequest(NETLINK_ROUTE, RTM_GETLINK, NLM_F_DUMP, ifinfomsg{}, cb);
-    performRequest(NETLINK_ROUTE, RTM_GETADDR, NLM_F_DUMP, ifaddrmsg{}, cb);
-    performRequest(NETLINK_ROUTE, RTM_GETROUTE, NLM_F_DUMP, rtmsg{}, cb);
-    performRequest(NETLINK_ROUTE, RTM_GETNEIGH, NLM_F_DUMP, ndmsg{}, cb);
+    // The dumps are captured too, so a replay starts from the same state
+    auto dgram = [&](std::string_view datagram) {
+        captureDatagram(capture, datagram);
+    };
+    performRequest(NETLINK_ROUTE, RTM_GETLINK, NLM_F_DUMP, ifinfomsg{}, cb,
+                   dgram);
+    performRequest(NETLINK_ROUTE, RTM_GETADDR, NLM_F_DUMP, ifaddrmsg{}, cb,
+                   dgram);
+    performRequest(NETLINK_ROUTE, RTM_GETROUTE, NLM_F_DUMP, rtmsg{}, cb,
+                   dgram);
+    performRequest(NETLINK_ROUTE, RTM_GETNEIGH, NLM_F_DUMP, ndmsg{}, cb,
+                   dgram);
 }
 
 } // namespace phosphor::network::netlink
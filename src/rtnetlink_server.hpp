@@ -1,8 +1,14 @@
 #pragma once
+#include "netlink_capture.hpp"
+
+#include <linux/netlink.h>
+
 #include <sdeventplus/event.hpp>
 #include <sdeventplus/source/io.hpp>
 #include <stdplus/fd/managed.hpp>
 
+#include <string_view>
+
 namespace phosphor
 {
 namespace network
@@ -11,6 +17,14 @@ class Manager;
 namespace netlink
 {
 
+/** @brief Applies a single rtnetlink message to the manager
+ *
+ *  @param[in] m    - The network manager that receives updates
+ *  @param[in] hdr  - The header of the message
+ *  @param[in] data - The payload of the message
+ */
+void handler(Manager& m, const nlmsghdr& hdr, std::string_view data);
+
 /** General rtnetlink server which waits for the POLLIN event
     and calls the  call back once it gets the event.
     Usage would be create the server with the  call back
@@ -25,8 +39,10 @@ class Server
      *
      *  @param[in] eventPtr - Unique ptr reference to sd_event.
      *  @param[in] manager  - The network manager that receives updates
+     *  @param[in] capture  - Optionally records every datagram received
      */
-    Server(sdeventplus::Event& event, Manager& manager);
+    Server(sdeventplus::Event& event, Manager& manager,
+           Capture* capture = nullptr);
 
     /** @brief Gets the socket associated with this netlink server */
     inline stdplus::Fd& getSock()
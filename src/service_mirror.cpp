@@ -0,0 +1,336 @@
+#include "service_mirror.hpp"
+
+#include "util.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+#include <sdbusplus/message.hpp>
+#include <stdplus/numeric/str.hpp>
+#include <stdplus/raw.hpp>
+
+#include <string_view>
+#include <tuple>
+#include <variant>
+
+namespace phosphor
+{
+namespace network
+{
+
+static constexpr char RESOLVED_SVC[] = "org.freedesktop.resolve1";
+static constexpr char RESOLVED_LINK_ROOT[] = "/org/freedesktop/resolve1/link";
+static constexpr char RESOLVED_LINK_INTF[] = "org.freedesktop.resolve1.Link";
+
+static constexpr char TIMESYNCD_SVC[] = "org.freedesktop.timesync1";
+static constexpr char TIMESYNCD_OBJ[] = "/org/freedesktop/timesync1";
+static constexpr char TIMESYNCD_INTF[] = "org.freedesktop.timesync1.Manager";
+
+static constexpr char PROPERTY_INTF[] = "org.freedesktop.DBus.Properties";
+
+static constexpr char resolvedMatchStr[] =
+    "type='signal',sender='org.freedesktop.resolve1',path_namespace='/org/"
+    "freedesktop/resolve1/link',interface='org.freedesktop.DBus.Properties',"
+    "member='PropertiesChanged',arg0='org.freedesktop.resolve1.Link'";
+static constexpr char resolvedOwnerMatchStr[] =
+    "type='signal',sender='org.freedesktop.DBus',interface='org.freedesktop."
+    "DBus',member='NameOwnerChanged',arg0='org.freedesktop.resolve1'";
+static constexpr char timesyncdMatchStr[] =
+    "type='signal',sender='org.freedesktop.timesync1',path='/org/freedesktop/"
+    "timesync1',interface='org.freedesktop.DBus.Properties',member='"
+    "PropertiesChanged',arg0='org.freedesktop.timesync1.Manager'";
+static constexpr char timesyncdOwnerMatchStr[] =
+    "type='signal',sender='org.freedesktop.DBus',interface='org.freedesktop."
+    "DBus',member='NameOwnerChanged',arg0='org.freedesktop.timesync1'";
+
+/*
+  The DNS property under org.freedesktop.resolve1.Link interface contains
+  an array containing all DNS servers currently used by resolved. It
+  contains similar information as the DNS server data written to
+  /run/systemd/resolve/resolv.conf.
+
+  Each structure in the array consists of a numeric network interface index,
+  an address family, and a byte array containing the DNS server address
+  (either 4 bytes in length for IPv4 or 16 bytes in lengths for IPv6).
+  The array contains DNS servers configured system-wide, including those
+  possibly read from a foreign /etc/resolv.conf or the DNS= setting in
+  /etc/systemd/resolved.conf, as well as per-interface DNS server
+  information either retrieved from systemd-networkd or configured by
+  external software via SetLinkDNS().
+*/
+using DNSProp = std::vector<std::tuple<int32_t, std::vector<uint8_t>>>;
+
+static ServerList serversFromDNS(const DNSProp& dns)
+{
+    ServerList servers;
+    for (const auto& [family, addr] : dns)
+    {
+        servers.push_back(stdplus::toStr(
+            addrFromBuf(family, stdplus::raw::asView<char>(addr))));
+    }
+    return servers;
+}
+
+/** @brief Reads the PropertiesChanged payload and looks for a single property
+ *
+ *  @param[in] m    - The PropertiesChanged signal
+ *  @param[in] name - The property name to look for
+ *  @return The new value, or nullopt if unchanged. If the property was only
+ *          invalidated, the returned variant is valueless and the caller must
+ *          re-query the value.
+ */
+template <typename T>
+static std::optional<std::optional<T>> readChanged(sdbusplus::message_t& m,
+                                                   std::string_view name)
+{
+    std::string intf;
+    std::unordered_map<std::string, std::variant<T>> values;
+    std::vector<std::string> invalidated;
+    m.read(intf, values, invalidated);
+    if (auto it = values.find(std::string(name)); it != values.end())
+    {
+        return std::make_optional(std::make_optional(
+            std::move(std::get<T>(it->second))));
+    }
+    for (const auto& prop : invalidated)
+    {
+        if (prop == name)
+        {
+            return std::make_optional(std::optional<T>());
+        }
+    }
+    return std::nullopt;
+}
+
+ServiceMirror::ServiceMirror(stdplus::PinnedRef<sdbusplus::bus_t> bus,
+                             DNSCallback&& dnsCb, NTPCallback&& ntpCb) :
+    bus(bus), dnsCb(std::move(dnsCb)), ntpCb(std::move(ntpCb)),
+    resolvedMatch(
+        bus, resolvedMatchStr,
+        [self = stdplus::PinnedRef(*this)](sdbusplus::message_t& m) {
+            try
+            {
+                auto ifidx = stdplus::StrToInt<10, unsigned>{}(
+                    sdbusplus::message::object_path(m.get_path()).filename());
+                auto val = readChanged<DNSProp>(m, "DNS");
+                if (!val)
+                {
+                    return;
+                }
+                if (!*val)
+                {
+                    self.get().refreshDNS(ifidx);
+                    return;
+                }
+                self.get().setDNS(ifidx, serversFromDNS(**val));
+            }
+            catch (const std::exception& e)
+            {
+                lg2::error("resolved DNS match parsing failed: {ERROR}",
+                           "ERROR", e);
+            }
+        }),
+    resolvedOwnerMatch(
+        bus, resolvedOwnerMatchStr,
+        [self = stdplus::PinnedRef(*this)](sdbusplus::message_t& m) {
+            std::string name, oldOwner, newOwner;
+            try
+            {
+                m.read(name, oldOwner, newOwner);
+            }
+            catch (const std::exception& e)
+            {
+                lg2::error("resolved owner match parsing failed: {ERROR}",
+                           "ERROR", e);
+                return;
+            }
+            std::vector<unsigned> links;
+            for (const auto& [ifidx, _] : self.get().dnsCalls)
+            {
+                links.push_back(ifidx);
+            }
+            for (auto ifidx : links)
+            {
+                // The servers went away with the service
+                if (newOwner.empty())
+                {
+                    self.get().setDNS(ifidx, {});
+                }
+                else
+                {
+                    self.get().refreshDNS(ifidx);
+                }
+            }
+        }),
+    timesyncdMatch(
+        bus, timesyncdMatchStr,
+        [self = stdplus::PinnedRef(*this)](sdbusplus::message_t& m) {
+            try
+            {
+                auto val = readChanged<ServerList>(m, "LinkNTPServers");
+                if (!val)
+                {
+                    return;
+                }
+                if (!*val)
+                {
+                    self.get().refreshNTP();
+                    return;
+                }
+                self.get().setNTP(std::move(**val));
+            }
+            catch (const std::exception& e)
+            {
+                lg2::error("timesyncd NTP match parsing failed: {ERROR}",
+                           "ERROR", e);
+            }
+        }),
+    timesyncdOwnerMatch(
+        bus, timesyncdOwnerMatchStr,
+        [self = stdplus::PinnedRef(*this)](sdbusplus::message_t& m) {
+            std::string name, oldOwner, newOwner;
+            try
+            {
+                m.read(name, oldOwner, newOwner);
+            }
+            catch (const std::exception& e)
+            {
+                lg2::error("timesyncd owner match parsing failed: {ERROR}",
+                           "ERROR", e);
+                return;
+            }
+            if (newOwner.empty())
+            {
+                // The servers went away with the service
+                self.get().setNTP({});
+                return;
+            }
+            self.get().refreshNTP();
+        })
+{}
+
+const ServerList& ServiceMirror::getDNS(unsigned ifidx) const noexcept
+{
+    static const ServerList empty;
+    auto it = dns.find(ifidx);
+    if (it == dns.end())
+    {
+        return empty;
+    }
+    return it->second;
+}
+
+void ServiceMirror::refreshDNS(unsigned ifidx, Startup::Ticket&& ticket)
+{
+    if (ifidx == 0)
+    {
+        return;
+    }
+    stdplus::ToStrHandle<stdplus::IntToStr<10, unsigned>> tsh;
+    auto obj = sdbusplus::message::object_path(RESOLVED_LINK_ROOT) /
+               std::string(tsh(ifidx));
+    try
+    {
+        auto req = bus.get().new_method_call(RESOLVED_SVC, obj.str.c_str(),
+                                             PROPERTY_INTF, "Get");
+        req.append(RESOLVED_LINK_INTF, "DNS");
+        dnsCalls.insert_or_assign(
+            ifidx, req.call_async([self = stdplus::PinnedRef(*this), ifidx,
+                                   ticket = std::move(ticket)](
+                                      sdbusplus::message_t& m) mutable {
+                auto done = std::move(ticket);
+                if (m.is_method_error())
+                {
+                    lg2::error("Failed to get DNS information from "
+                               "systemd-resolved for {NET_IDX}: {ERROR}",
+                               "NET_IDX", ifidx, "ERROR",
+                               m.get_error()->message);
+                    return;
+                }
+                try
+                {
+                    std::variant<DNSProp> val;
+                    m.read(val);
+                    self.get().setDNS(ifidx,
+                                      serversFromDNS(std::get<DNSProp>(val)));
+                }
+                catch (const std::exception& e)
+                {
+                    lg2::error("Failed to parse DNS information from "
+                               "systemd-resolved for {NET_IDX}: {ERROR}",
+                               "NET_IDX", ifidx, "ERROR", e);
+                }
+            }));
+    }
+    catch (const std::exception& e)
+    {
+        lg2::error("Failed to query systemd-resolved for {NET_IDX}: {ERROR}",
+                   "NET_IDX", ifidx, "ERROR", e);
+    }
+}
+
+void ServiceMirror::refreshNTP(Startup::Ticket&& ticket)
+{
+    try
+    {
+        auto req = bus.get().new_method_call(TIMESYNCD_SVC, TIMESYNCD_OBJ,
+                                             PROPERTY_INTF, "Get");
+        req.append(TIMESYNCD_INTF, "LinkNTPServers");
+        ntpCall.emplace(req.call_async(
+            [self = stdplus::PinnedRef(*this),
+             ticket = std::move(ticket)](sdbusplus::message_t& m) mutable {
+                auto done = std::move(ticket);
+                if (m.is_method_error())
+                {
+                    lg2::error("Failed to get NTP server information from "
+                               "systemd-timesyncd: {ERROR}",
+                               "ERROR", m.get_error()->message);
+                    return;
+                }
+                try
+                {
+                    std::variant<ServerList> val;
+                    m.read(val);
+                    self.get().setNTP(std::move(std::get<ServerList>(val)));
+                }
+                catch (const std::exception& e)
+                {
+                    lg2::error("Failed to parse NTP server information from "
+                               "systemd-timesyncd: {ERROR}",
+                               "ERROR", e);
+                }
+            }));
+    }
+    catch (const std::exception& e)
+    {
+        lg2::error("Failed to query systemd-timesyncd: {ERROR}", "ERROR", e);
+    }
+}
+
+void ServiceMirror::forgetLink(unsigned ifidx)
+{
+    dnsCalls.erase(ifidx);
+    dns.erase(ifidx);
+}
+
+void ServiceMirror::setDNS(unsigned ifidx, ServerList&& servers)
+{
+    auto& cur = dns[ifidx];
+    if (cur == servers)
+    {
+        return;
+    }
+    cur = std::move(servers);
+    dnsCb(ifidx);
+}
+
+void ServiceMirror::setNTP(ServerList&& servers)
+{
+    if (ntp == servers)
+    {
+        return;
+    }
+    ntp = std::move(servers);
+    ntpCb();
+}
+
+} // namespace network
+} // namespace phosphor
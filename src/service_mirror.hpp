@@ -0,0 +1,96 @@
+#pragma once
+#include "startup.hpp"
+
+#include <function2/function2.hpp>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/slot.hpp>
+#include <stdplus/pinned.hpp>
+
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace phosphor
+{
+namespace network
+{
+
+using ServerList = std::vector<std::string>;
+
+/** @class ServiceMirror
+ *  @brief In-memory copy of the link state owned by systemd-resolved and
+ *         systemd-timesyncd.
+ *  @details The cache is kept up to date from PropertiesChanged signals and
+ *           asynchronous Gets, so property getters never have to make a
+ *           blocking call to another service.
+ */
+class ServiceMirror
+{
+  public:
+    /** @brief Called with the ifidx whose DNS servers were updated */
+    using DNSCallback = fu2::unique_function<void(unsigned)>;
+    /** @brief Called after the NTP servers were updated */
+    using NTPCallback = fu2::unique_function<void()>;
+
+    ServiceMirror(ServiceMirror&&) = delete;
+    ServiceMirror& operator=(ServiceMirror&&) = delete;
+
+    /** @brief Constructor
+     *  @param[in] bus   - Bus to watch for updates on.
+     *  @param[in] dnsCb - Called when the DNS servers of a link change.
+     *  @param[in] ntpCb - Called when the NTP servers change.
+     */
+    ServiceMirror(stdplus::PinnedRef<sdbusplus::bus_t> bus, DNSCallback&& dnsCb,
+                  NTPCallback&& ntpCb);
+
+    /** @brief Gets the cached DNS servers of the link */
+    const ServerList& getDNS(unsigned ifidx) const noexcept;
+
+    /** @brief Gets the cached NTP servers */
+    inline const ServerList& getNTP() const noexcept
+    {
+        return ntp;
+    }
+
+    /** @brief Starts an asynchronous refresh of the DNS servers of a link
+     *  @param[in] ticket - Completed once the reply has been processed.
+     */
+    void refreshDNS(unsigned ifidx, Startup::Ticket&& ticket = {});
+
+    /** @brief Starts an asynchronous refresh of the NTP servers
+     *  @param[in] ticket - Completed once the reply has been processed.
+     */
+    void refreshNTP(Startup::Ticket&& ticket = {});
+
+    /** @brief Drops all cached state for a link */
+    void forgetLink(unsigned ifidx);
+
+  private:
+    /** @brief Persistent sdbusplus DBus bus connection. */
+    stdplus::PinnedRef<sdbusplus::bus_t> bus;
+
+    DNSCallback dnsCb;
+    NTPCallback ntpCb;
+
+    /** @brief Cached per-link DNS servers */
+    std::unordered_map<unsigned, ServerList> dns;
+    /** @brief Cached NTP servers */
+    ServerList ntp;
+
+    /** @brief Outstanding asynchronous Gets */
+    std::unordered_map<unsigned, sdbusplus::slot_t> dnsCalls;
+    std::optional<sdbusplus::slot_t> ntpCall;
+
+    sdbusplus::bus::match_t resolvedMatch;
+    sdbusplus::bus::match_t resolvedOwnerMatch;
+    sdbusplus::bus::match_t timesyncdMatch;
+    sdbusplus::bus::match_t timesyncdOwnerMatch;
+
+    void setDNS(unsigned ifidx, ServerList&& servers);
+    void setNTP(ServerList&& servers);
+};
+
+} // namespace network
+} // namespace phosphor
@@ -0,0 +1,155 @@
+#include "config.h"
+
+#include "stall_monitor.hpp"
+
+#include <systemd/sd-bus.h>
+#include <systemd/sd-event.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <system_error>
+
+namespace phosphor
+{
+namespace network
+{
+namespace stall
+{
+
+using std::literals::string_view_literals::operator""sv;
+
+static constexpr auto unlabeled = "event"sv;
+
+static auto toMs(Clock::duration d) noexcept
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(d).count();
+}
+
+Monitor::Monitor() :
+    budget(std::chrono::milliseconds(STALL_BUDGET_MS)), current(unlabeled)
+{
+    slowest.reserve(topN + 1);
+}
+
+void Monitor::label(std::string_view kind, std::string_view name,
+                    std::string_view member)
+{
+    current.assign(kind);
+    current.append(" "sv);
+    current.append(name);
+    if (!member.empty())
+    {
+        current.append("."sv);
+        current.append(member);
+    }
+}
+
+void Monitor::record(Clock::duration duration)
+{
+    if (duration > budget)
+    {
+        stalls++;
+        lg2::warning("Event loop stalled for {DURATION_MS}ms handling "
+                     "{SOURCE}",
+                     "DURATION_MS", toMs(duration), "SOURCE", current);
+    }
+    if (slowest.size() < topN || duration > slowest.back().duration)
+    {
+        auto it = std::upper_bound(
+            slowest.begin(), slowest.end(), duration,
+            [](Clock::duration d, const Entry& e) { return d > e.duration; });
+        slowest.insert(it, Entry{current, duration});
+        if (slowest.size() > topN)
+        {
+            slowest.pop_back();
+        }
+    }
+    current.assign(unlabeled);
+}
+
+static int labelMessage(sd_bus_message* m, void* userdata, sd_bus_error*)
+{
+    auto& monitor = *reinterpret_cast<Monitor*>(userdata);
+    const char* intf = sd_bus_message_get_interface(m);
+    const char* member = sd_bus_message_get_member(m);
+    if (member == nullptr)
+    {
+        return 0;
+    }
+    std::string_view kind =
+        sd_bus_message_is_signal(m, nullptr, nullptr) > 0 ? "signal"sv
+                                                           : "method"sv;
+    if (intf == nullptr)
+    {
+        monitor.label(kind, member);
+    }
+    else
+    {
+        monitor.label(kind, intf, member);
+    }
+    return 0;
+}
+
+struct SlotDeleter
+{
+    void operator()(sd_bus_slot* slot) const noexcept
+    {
+        sd_bus_slot_unref(slot);
+    }
+};
+
+int Monitor::loop(sdeventplus::Event& event, sdbusplus::bus_t& bus)
+{
+    bus.attach_event(event.get(), SD_EVENT_PRIORITY_NORMAL);
+    struct Detach
+    {
+        sdbusplus::bus_t& bus;
+        ~Detach()
+        {
+            bus.detach_event();
+        }
+    } detach{bus};
+
+    sd_bus_slot* slot = nullptr;
+    if (int r = sd_bus_add_filter(bus.get(), &slot, labelMessage, this); r < 0)
+    {
+        throw std::system_error(-r, std::generic_category(),
+                                "sd_bus_add_filter");
+    }
+    std::unique_ptr<sd_bus_slot, SlotDeleter> filter(slot);
+
+    auto e = event.get();
+    while (sd_event_get_state(e) != SD_EVENT_FINISHED)
+    {
+        int r = sd_event_prepare(e);
+        if (r == 0)
+        {
+            r = sd_event_wait(e, UINT64_MAX);
+        }
+        if (r > 0)
+        {
+            auto start = Clock::now();
+            r = sd_event_dispatch(e);
+            record(Clock::now() - start);
+        }
+        if (r < 0)
+        {
+            throw std::system_error(-r, std::generic_category(), "sd_event");
+        }
+    }
+    int code = 0;
+    sd_event_get_exit_code(e, &code);
+    return code;
+}
+
+Monitor& get() noexcept
+{
+    static Monitor monitor;
+    return monitor;
+}
+
+} // namespace stall
+} // namespace network
+} // namespace phosphor
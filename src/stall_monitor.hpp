@@ -0,0 +1,90 @@
+#pragma once
+#include <sdbusplus/bus.hpp>
+#include <sdeventplus/event.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace phosphor
+{
+namespace network
+{
+namespace stall
+{
+
+using Clock = std::chrono::steady_clock;
+
+/** @class Monitor
+ *  @brief Measures the wall time of every event loop dispatch and keeps the
+ *         slowest ones along with what was being handled.
+ *  @details Handlers describe themselves by setting a label during the
+ *           dispatch. D-Bus method calls and signals are labeled
+ *           automatically from a bus filter.
+ */
+class Monitor
+{
+  public:
+    /** @brief Number of slowest dispatches kept */
+    static constexpr size_t topN = 16;
+
+    struct Entry
+    {
+        std::string source;
+        Clock::duration duration;
+    };
+
+    Monitor();
+    Monitor(Monitor&&) = delete;
+    Monitor& operator=(Monitor&&) = delete;
+
+    /** @brief Describes what the current dispatch is handling */
+    void label(std::string_view kind, std::string_view name,
+               std::string_view member = {});
+
+    /** @brief Accounts a dispatch of the given duration to the label */
+    void record(Clock::duration duration);
+
+    inline Clock::duration getBudget() const noexcept
+    {
+        return budget;
+    }
+    inline void setBudget(Clock::duration budget) noexcept
+    {
+        this->budget = budget;
+    }
+
+    /** @brief Number of dispatches that exceeded the budget */
+    inline uint64_t getStalls() const noexcept
+    {
+        return stalls;
+    }
+
+    /** @brief Slowest dispatches, slowest first */
+    inline const std::vector<Entry>& getSlowest() const noexcept
+    {
+        return slowest;
+    }
+
+    /** @brief Runs the event loop with the bus attached, measuring every
+     *         dispatch, until the event loop exits.
+     *  @return The exit code of the event loop
+     */
+    int loop(sdeventplus::Event& event, sdbusplus::bus_t& bus);
+
+  private:
+    Clock::duration budget;
+    uint64_t stalls = 0;
+    std::vector<Entry> slowest;
+    /** @brief Label of the running dispatch, reused to avoid allocations */
+    std::string current;
+};
+
+/** @brief Gets the process wide monitor */
+Monitor& get() noexcept;
+
+} // namespace stall
+} // namespace network
+} // namespace phosphor
@@ -0,0 +1,127 @@
+#include "startup.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <utility>
+
+namespace phosphor
+{
+namespace network
+{
+
+static auto toMs(Startup::Clock::duration d) noexcept
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(d).count();
+}
+
+Startup::Ticket::Ticket(Startup& startup, size_t phase) noexcept :
+    startup(&startup), phase(phase)
+{}
+
+Startup::Ticket::Ticket(Ticket&& other) noexcept :
+    startup(std::exchange(other.startup, nullptr)), phase(other.phase)
+{}
+
+Startup::Ticket& Startup::Ticket::operator=(Ticket&& other) noexcept
+{
+    if (this != &other)
+    {
+        done();
+        startup = std::exchange(other.startup, nullptr);
+        phase = other.phase;
+    }
+    return *this;
+}
+
+Startup::Ticket::~Ticket()
+{
+    done();
+}
+
+void Startup::Ticket::done() noexcept
+{
+    if (startup != nullptr)
+    {
+        std::exchange(startup, nullptr)->finish(phase);
+    }
+}
+
+Startup::Startup() : startTime(Clock::now()) {}
+
+Startup::Ticket Startup::begin(std::string_view phase)
+{
+    if (ready)
+    {
+        return {};
+    }
+    auto it = std::find_if(phases.begin(), phases.end(),
+                           [&](const Phase& p) { return p.name == phase; });
+    if (it == phases.end())
+    {
+        it = phases.insert(it, Phase{std::string(phase), Clock::now(), {}, 0});
+    }
+    it->pending++;
+    pending++;
+    return Ticket(*this, it - phases.begin());
+}
+
+void Startup::seal()
+{
+    sealed = true;
+    checkReady();
+}
+
+void Startup::onReady(fu2::unique_function<void()>&& cb)
+{
+    readyCbs.push_back(std::move(cb));
+}
+
+void Startup::finish(size_t phase) noexcept
+{
+    auto& p = phases[phase];
+    p.end = Clock::now();
+    p.pending--;
+    pending--;
+    checkReady();
+}
+
+void Startup::checkReady() noexcept
+{
+    if (ready || !sealed || pending != 0)
+    {
+        return;
+    }
+    ready = true;
+    readyTime = Clock::now();
+    try
+    {
+        lg2::info("Startup complete in {DURATION_MS}ms", "DURATION_MS",
+                  toMs(getTotal()));
+        for (const auto& p : phases)
+        {
+            lg2::info("Startup phase {PHASE} took {DURATION_MS}ms", "PHASE",
+                      p.name, "DURATION_MS", toMs(p.end - p.start));
+        }
+    }
+    catch (const std::exception& e)
+    {
+        lg2::error("Startup logging failed: {ERROR}", "ERROR", e);
+    }
+    for (auto& cb : readyCbs)
+    {
+        try
+        {
+            cb();
+        }
+        catch (const std::exception& e)
+        {
+            lg2::error("Startup completion callback failed: {ERROR}", "ERROR",
+                       e);
+        }
+    }
+    readyCbs.clear();
+}
+
+} // namespace network
+} // namespace phosphor
@@ -0,0 +1,106 @@
+#pragma once
+#include <function2/function2.hpp>
+
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace phosphor
+{
+namespace network
+{
+
+/** @class Startup
+ *  @brief Tracks the queries the daemon issues to other services while
+ *         starting up.
+ *  @details Every query holds a Ticket for the phase it belongs to. Queries
+ *           run concurrently and the daemon is considered ready once the
+ *           tracker is sealed and every ticket has completed.
+ */
+class Startup
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Phase
+    {
+        std::string name;
+        Clock::time_point start;
+        Clock::time_point end;
+        size_t pending = 0;
+    };
+
+    /** @class Ticket
+     *  @brief Handle to a single outstanding startup query. The query is
+     *         considered complete when done() is called or the ticket is
+     *         destroyed.
+     */
+    class Ticket
+    {
+      public:
+        Ticket() = default;
+        Ticket(Ticket&& other) noexcept;
+        Ticket& operator=(Ticket&& other) noexcept;
+        ~Ticket();
+
+        /** @brief Marks the query as complete */
+        void done() noexcept;
+
+      private:
+        Startup* startup = nullptr;
+        size_t phase = 0;
+
+        Ticket(Startup& startup, size_t phase) noexcept;
+
+        friend class Startup;
+    };
+
+    Startup();
+    Startup(Startup&&) = delete;
+    Startup& operator=(Startup&&) = delete;
+
+    /** @brief Starts tracking a query belonging to the named phase.
+     *         Returns an empty ticket once startup is complete.
+     */
+    Ticket begin(std::string_view phase);
+
+    /** @brief Signals that no new phases are expected to start. Readiness is
+     *         reported as soon as all outstanding tickets are done.
+     */
+    void seal();
+
+    /** @brief Adds a callback invoked once startup is complete */
+    void onReady(fu2::unique_function<void()>&& cb);
+
+    inline bool isReady() const noexcept
+    {
+        return ready;
+    }
+
+    inline const std::vector<Phase>& getPhases() const noexcept
+    {
+        return phases;
+    }
+
+    /** @brief Time from construction until readiness */
+    inline Clock::duration getTotal() const noexcept
+    {
+        return readyTime - startTime;
+    }
+
+  private:
+    Clock::time_point startTime;
+    Clock::time_point readyTime;
+    std::vector<Phase> phases;
+    size_t pending = 0;
+    bool sealed = false;
+    bool ready = false;
+    std::vector<fu2::unique_function<void()>> readyCbs;
+
+    void finish(size_t phase) noexcept;
+    void checkReady() noexcept;
+};
+
+} // namespace network
+} // namespace phosphor
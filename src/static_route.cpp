@@ -0,0 +1,116 @@
+#include "static_route.hpp"
+
+#include "ethernet_interface.hpp"
+
+#include <linux/rtnetlink.h>
+
+#include <phosphor-logging/elog-errors.hpp>
+#include <phosphor-logging/elog.hpp>
+#include <xyz/openbmc_project/Common/error.hpp>
+
+#include <memory>
+#include <string>
+
+namespace phosphor
+{
+namespace network
+{
+
+static auto makeObjPath(std::string_view root, stdplus::SubnetAny dst)
+{
+    auto ret = sdbusplus::message::object_path(std::string(root));
+    ret /= "route";
+    stdplus::ToStrHandle<stdplus::ToStr<stdplus::SubnetAny>> tsh;
+    ret /= tsh(dst);
+    return ret;
+}
+
+StaticRoute::StaticRoute(sdbusplus::bus_t& bus, std::string_view objRoot,
+                         stdplus::PinnedRef<EthernetInterface> parent,
+                         stdplus::SubnetAny dst,
+                         std::optional<stdplus::InAnyAddr> gateway,
+                         uint32_t metric) :
+    StaticRoute(bus, makeObjPath(objRoot, dst), parent, dst, gateway, metric)
+{}
+
+StaticRoute::StaticRoute(sdbusplus::bus_t& bus,
+                         sdbusplus::message::object_path objPath,
+                         stdplus::PinnedRef<EthernetInterface> parent,
+                         stdplus::SubnetAny dst,
+                         std::optional<stdplus::InAnyAddr> gateway,
+                         uint32_t metric) :
+    StaticRouteObj(bus, objPath.str.c_str(),
+                   StaticRouteObj::action::defer_emit),
+    parent(parent), objPath(std::move(objPath)), dst(dst), gw(gateway)
+{
+    StaticRouteObj::destination(stdplus::toStr(dst.getAddr()), true);
+    StaticRouteObj::prefixLength(dst.getPfx(), true);
+    StaticRouteObj::gateway(gateway ? stdplus::toStr(*gateway) : "", true);
+    StaticRouteObj::metric(metric, true);
+    emit_object_added();
+}
+
+void StaticRoute::update(std::optional<stdplus::InAnyAddr> gateway,
+                         uint32_t metric)
+{
+    if (gw != gateway)
+    {
+        gw = gateway;
+        StaticRouteObj::gateway(gateway ? stdplus::toStr(*gateway) : "");
+    }
+    StaticRouteObj::metric(metric);
+}
+
+RouteInfo StaticRoute::routeInfo(unsigned ifidx) const
+{
+    return RouteInfo{.table = RT_TABLE_MAIN,
+                     .protocol = RTPROT_STATIC,
+                     .scope = gw ? uint8_t{RT_SCOPE_UNIVERSE}
+                                 : uint8_t{RT_SCOPE_LINK},
+                     .type = RTN_UNICAST,
+                     .dst = dst,
+                     .priority = metric(),
+                     .nexthops = {{.oif = ifidx, .gateway = gw}}};
+}
+
+void StaticRoute::delete_()
+{
+    auto& routes = parent.get().staticRoutes;
+    std::unique_ptr<StaticRoute> ptr;
+    if (auto it = routes.find(dst); it != routes.end())
+    {
+        ptr = std::move(it->second);
+        routes.erase(it);
+    }
+
+    auto info = routeInfo(parent.get().getIfIdx());
+    parent.get().applyRoutes({&info, 1}, {});
+}
+
+using sdbusplus::xyz::openbmc_project::Common::Error::NotAllowed;
+using REASON =
+    phosphor::logging::xyz::openbmc_project::Common::NotAllowed::REASON;
+using phosphor::logging::elog;
+
+std::string StaticRoute::destination(std::string /*destination*/)
+{
+    elog<NotAllowed>(REASON("Property update is not allowed"));
+}
+
+uint8_t StaticRoute::prefixLength(uint8_t /*prefixLength*/)
+{
+    elog<NotAllowed>(REASON("Property update is not allowed"));
+}
+
+std::string StaticRoute::gateway(std::string /*gateway*/)
+{
+    elog<NotAllowed>(REASON("Property update is not allowed"));
+}
+
+uint32_t StaticRoute::metric(uint32_t /*metric*/)
+{
+    elog<NotAllowed>(REASON("Property update is not allowed"));
+}
+
+} // namespace network
+} // namespace phosphor
@@ -0,0 +1,104 @@
+#pragma once
+#include "statistics.hpp"
+#include "types.hpp"
+#include "xyz/openbmc_project/Network/Route/Static/server.hpp"
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/message/native_types.hpp>
+#include <sdbusplus/server/object.hpp>
+#include <stdplus/net/addr/ip.hpp>
+#include <stdplus/net/addr/subnet.hpp>
+#include <stdplus/pinned.hpp>
+#include <xyz/openbmc_project/Object/Delete/server.hpp>
+
+#include <optional>
+#include <string_view>
+
+namespace phosphor
+{
+namespace network
+{
+
+using StaticRouteIntf =
+    sdbusplus::xyz::openbmc_project::Network::Route::server::Static;
+
+using StaticRouteObj = sdbusplus::server::object_t<
+    StaticRouteIntf, sdbusplus::xyz::openbmc_project::Object::server::Delete>;
+
+class EthernetInterface;
+
+/** @class StaticRoute
+ *  @brief OpenBMC static route implementation.
+ *  @details A concrete implementation for the
+ *  xyz.openbmc_project.Network.Route.Static dbus interface.
+ */
+class StaticRoute : public StaticRouteObj
+{
+  public:
+    /** @brief Constructor to put object onto bus at a dbus path.
+     *  @param[in] bus - Bus to attach to.
+     *  @param[in] objRoot - Path of the parent interface.
+     *  @param[in] parent - Parent object.
+     *  @param[in] dst - Destination subnet.
+     *  @param[in] gateway - Next hop, if not directly reachable.
+     *  @param[in] metric - Priority of the route.
+     */
+    StaticRoute(sdbusplus::bus_t& bus, std::string_view objRoot,
+                stdplus::PinnedRef<EthernetInterface> parent,
+                stdplus::SubnetAny dst,
+                std::optional<stdplus::InAnyAddr> gateway, uint32_t metric);
+
+    /** @brief Delete this d-bus object.
+     */
+    void delete_() override;
+
+    using StaticRouteObj::destination;
+    std::string destination(std::string) override;
+    using StaticRouteObj::prefixLength;
+    uint8_t prefixLength(uint8_t) override;
+    using StaticRouteObj::gateway;
+    std::string gateway(std::string) override;
+    using StaticRouteObj::metric;
+    uint32_t metric(uint32_t) override;
+
+    /** @brief Updates the next hop and metric in place */
+    void update(std::optional<stdplus::InAnyAddr> gateway, uint32_t metric);
+
+    /** @brief The route as programmed into the kernel */
+    RouteInfo routeInfo(unsigned ifidx) const;
+
+    inline const auto& getObjPath() const
+    {
+        return objPath;
+    }
+    inline auto getDst() const noexcept
+    {
+        return dst;
+    }
+    inline const auto& getGateway() const noexcept
+    {
+        return gw;
+    }
+
+  private:
+    /** @brief Parent Object. */
+    stdplus::PinnedRef<EthernetInterface> parent;
+
+    /** @brief Dbus object path */
+    sdbusplus::message::object_path objPath;
+
+    /** @brief Key of this object in the parent's route map */
+    stdplus::SubnetAny dst;
+
+    std::optional<stdplus::InAnyAddr> gw;
+
+    [[no_unique_address]] stats::LiveObject<stats::Object::StaticRoute> live;
+
+    StaticRoute(sdbusplus::bus_t& bus, sdbusplus::message::object_path objPath,
+                stdplus::PinnedRef<EthernetInterface> parent,
+                stdplus::SubnetAny dst,
+                std::optional<stdplus::InAnyAddr> gateway, uint32_t metric);
+};
+
+} // namespace network
+} // namespace phosphor
@@ -0,0 +1,256 @@
+#include "statistics.hpp"
+
+#include <malloc.h>
+#include <unistd.h>
+
+#include <sdbusplus/exception.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <format>
+#include <fstream>
+
+namespace phosphor
+{
+namespace network
+{
+namespace stats
+{
+
+using std::literals::string_view_literals::operator""sv;
+
+void Histogram::record(Clock::duration d) noexcept
+{
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+    size_t bucket = us <= 0 ? 0 : std::bit_width(static_cast<uint64_t>(us));
+    add(counts[std::min(bucket, buckets - 1)]);
+}
+
+std::vector<uint64_t> Histogram::snapshot() const
+{
+    std::vector<uint64_t> ret;
+    ret.reserve(buckets);
+    for (const auto& c : counts)
+    {
+        ret.push_back(load(c));
+    }
+    return ret;
+}
+
+std::string_view netlinkTypeName(uint16_t type) noexcept
+{
+    switch (type)
+    {
+        case RTM_NEWLINK:
+            return "NEWLINK"sv;
+        case RTM_DELLINK:
+            return "DELLINK"sv;
+        case RTM_NEWADDR:
+            return "NEWADDR"sv;
+        case RTM_DELADDR:
+            return "DELADDR"sv;
+        case RTM_NEWROUTE:
+            return "NEWROUTE"sv;
+        case RTM_DELROUTE:
+            return "DELROUTE"sv;
+        case RTM_NEWNEIGH:
+            return "NEWNEIGH"sv;
+        case RTM_DELNEIGH:
+            return "DELNEIGH"sv;
+    }
+    return "OTHER"sv;
+}
+
+std::map<std::string, uint64_t> Statistics::netlinkSnapshot() const
+{
+    std::map<std::string, uint64_t> ret;
+    for (uint16_t type = 0; type < netlinkMsgs.size(); ++type)
+    {
+        if (auto n = load(netlinkMsgs[type]); n != 0)
+        {
+            ret[std::string(netlinkTypeName(type))] += n;
+        }
+    }
+    return ret;
+}
+
+std::map<std::string, uint64_t> Statistics::objectSnapshot() const
+{
+    std::map<std::string, uint64_t> ret;
+    for (size_t i = 0; i < objectNames.size(); ++i)
+    {
+        ret.emplace(objectNames[i], load(objects[i]));
+    }
+    return ret;
+}
+
+uint64_t heapBytes() noexcept
+{
+    auto info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+uint64_t residentBytes() noexcept
+{
+    // statm reports the total and resident sizes in pages
+    std::ifstream statm("/proc/self/statm");
+    uint64_t size = 0, resident = 0;
+    if (!(statm >> size >> resident))
+    {
+        return 0;
+    }
+    return resident * sysconf(_SC_PAGESIZE);
+}
+
+Statistics& get() noexcept
+{
+    static Statistics stats;
+    return stats;
+}
+
+/** @brief sdbusplus owns the userdata and destroy callback of the slots it
+ *         makes calls on, so the handler of the call and its start time are
+ *         kept in the slot description. sd-bus frees it with the slot,
+ *         whether a reply ever arrives or the call is cancelled.
+ */
+static std::string describeCall(sd_bus_message_handler_t callback,
+                                Clock::time_point start)
+{
+    return std::format("{:x} {}", reinterpret_cast<uintptr_t>(callback),
+                       start.time_since_epoch().count());
+}
+
+static int asyncReply(sd_bus_message* m, void* userdata,
+                      sd_bus_error* ret_error)
+{
+    auto now = Clock::now();
+    auto* slot = sd_bus_get_current_slot(sd_bus_message_get_bus(m));
+    const char* desc = nullptr;
+    if (slot == nullptr || sd_bus_slot_get_description(slot, &desc) < 0)
+    {
+        return -EINVAL;
+    }
+    const char* end = desc + std::strlen(desc);
+    uintptr_t callback = 0;
+    Clock::rep start = 0;
+    auto r = std::from_chars(desc, end, callback, 16);
+    if (r.ec != std::errc{} || r.ptr == end ||
+        std::from_chars(r.ptr + 1, end, start).ec != std::errc{})
+    {
+        return -EINVAL;
+    }
+    get().methodCallLatency.record(
+        now - Clock::time_point(Clock::duration(start)));
+    return reinterpret_cast<sd_bus_message_handler_t>(callback)(m, userdata,
+                                                                ret_error);
+}
+
+int CountingSdBus::sd_bus_call(sd_bus* bus, sd_bus_message* m, uint64_t usec,
+                               sd_bus_error* ret_error,
+                               sd_bus_message** reply)
+{
+    add(get().methodCalls);
+    auto start = Clock::now();
+    auto r = SdBusImpl::sd_bus_call(bus, m, usec, ret_error, reply);
+    get().methodCallLatency.record(Clock::now() - start);
+    return r;
+}
+
+int CountingSdBus::sd_bus_call_async(sd_bus* bus, sd_bus_slot** slot,
+                                     sd_bus_message* m,
+                                     sd_bus_message_handler_t callback,
+                                     void* userdata, uint64_t usec)
+{
+    add(get().methodCalls);
+    if (slot == nullptr || callback == nullptr)
+    {
+        return SdBusImpl::sd_bus_call_async(bus, slot, m, callback, userdata,
+                                            usec);
+    }
+    auto desc = describeCall(callback, Clock::now());
+    auto r = SdBusImpl::sd_bus_call_async(bus, slot, m, asyncReply, userdata,
+                                          usec);
+    if (r < 0)
+    {
+        return r;
+    }
+    // Without its description the reply could not be handed on, so the
+    // call is cancelled and reported as failed instead
+    if (auto d = sd_bus_slot_set_description(*slot, desc.c_str()); d < 0)
+    {
+        *slot = sd_bus_slot_unref(*slot);
+        return d;
+    }
+    return r;
+}
+
+int CountingSdBus::sd_bus_send(sd_bus* bus, sd_bus_message* m,
+                               uint64_t* cookie)
+{
+    if (sd_bus_message_is_signal(m, nullptr, nullptr) > 0)
+    {
+        add(get().signalsEmitted);
+    }
+    return SdBusImpl::sd_bus_send(bus, m, cookie);
+}
+
+int CountingSdBus::sd_bus_emit_interfaces_added_strv(sd_bus* bus,
+                                                     const char* path,
+                                                     char** interfaces)
+{
+    add(get().signalsEmitted);
+    return SdBusImpl::sd_bus_emit_interfaces_added_strv(bus, path,
+                                                        interfaces);
+}
+
+int CountingSdBus::sd_bus_emit_interfaces_removed_strv(sd_bus* bus,
+                                                       const char* path,
+                                                       char** interfaces)
+{
+    add(get().signalsEmitted);
+    return SdBusImpl::sd_bus_emit_interfaces_removed_strv(bus, path,
+                                                          interfaces);
+}
+
+int CountingSdBus::sd_bus_emit_object_added(sd_bus* bus, const char* path)
+{
+    add(get().signalsEmitted);
+    return SdBusImpl::sd_bus_emit_object_added(bus, path);
+}
+
+int CountingSdBus::sd_bus_emit_object_removed(sd_bus* bus, const char* path)
+{
+    add(get().signalsEmitted);
+    return SdBusImpl::sd_bus_emit_object_removed(bus, path);
+}
+
+int CountingSdBus::sd_bus_emit_properties_changed_strv(sd_bus* bus,
+                                                       const char* path,
+                                                       const char* interface,
+                                                       const char** names)
+{
+    add(get().signalsEmitted);
+    return SdBusImpl::sd_bus_emit_properties_changed_strv(bus, path, interface,
+                                                          names);
+}
+
+sdbusplus::bus_t newDefaultBus(CountingSdBus& intf)
+{
+    sd_bus* b = nullptr;
+    int r = sd_bus_default(&b);
+    if (r < 0)
+    {
+        throw sdbusplus::exception::SdBusError(-r, "sd_bus_default");
+    }
+    // The bus takes its own reference
+    sdbusplus::bus_t bus(b, &intf);
+    sd_bus_unref(b);
+    return bus;
+}
+
+} // namespace stats
+} // namespace network
+} // namespace phosphor
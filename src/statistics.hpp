@@ -0,0 +1,186 @@
+#pragma once
+#include <linux/rtnetlink.h>
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/sdbus.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace phosphor
+{
+namespace network
+{
+namespace stats
+{
+
+using Clock = std::chrono::steady_clock;
+using Counter = std::atomic<uint64_t>;
+
+/** @brief Bumps a counter without ordering against other memory accesses */
+inline void add(Counter& c, uint64_t n = 1) noexcept
+{
+    c.fetch_add(n, std::memory_order_relaxed);
+}
+
+inline uint64_t load(const Counter& c) noexcept
+{
+    return c.load(std::memory_order_relaxed);
+}
+
+/** @class Histogram
+ *  @brief Latency histogram with power of two microsecond buckets. Bucket
+ *         0 holds latencies under 1us, bucket N holds [2^(N-1), 2^N)us and
+ *         the last bucket holds everything above. The buckets reach 2^25us,
+ *         about 33s, so that breaches of the apply SLO stand apart.
+ */
+class Histogram
+{
+  public:
+    static constexpr size_t buckets = 27;
+
+    void record(Clock::duration d) noexcept;
+    std::vector<uint64_t> snapshot() const;
+
+  private:
+    std::array<Counter, buckets> counts = {};
+};
+
+/** @brief Kinds of D-Bus requested changes whose apply latency is tracked */
+enum class ApplyOp : size_t
+{
+    Address,
+    Gateway,
+};
+inline constexpr std::array<const char*, 2> applyOpNames = {"Address",
+                                                            "Gateway"};
+
+/** @brief Kinds of D-Bus objects whose live instances are counted */
+enum class Object : size_t
+{
+    Interface,
+    DHCPConfiguration,
+    IPAddress,
+    Neighbor,
+    VLAN,
+    StaticRoute,
+};
+inline constexpr std::array<const char*, 6> objectNames = {
+    "EthernetInterface", "DHCPConfiguration", "IPAddress", "Neighbor",
+    "VLAN", "StaticRoute"};
+
+/** @brief All of the counters of the process */
+struct Statistics
+{
+    std::array<Counter, RTM_MAX + 1> netlinkMsgs = {};
+    Counter netlinkParseErrors = 0;
+    Counter ignoredIntfEvents = 0;
+
+    Counter configsWritten = 0;
+    Counter configsSkipped = 0;
+    Counter configBytesWritten = 0;
+
+    Counter reloads = 0;
+    Histogram reloadLatency;
+
+    Counter signalsEmitted = 0;
+    Counter methodCalls = 0;
+    Histogram methodCallLatency;
+
+    std::array<Histogram, applyOpNames.size()> applyLatency;
+    std::array<Counter, applyOpNames.size()> applyNotConverged = {};
+
+    std::array<Counter, objectNames.size()> objects = {};
+
+    /** @brief Snapshot of the non-zero netlink message counts by type */
+    std::map<std::string, uint64_t> netlinkSnapshot() const;
+
+    /** @brief Snapshot of the live object counts by kind */
+    std::map<std::string, uint64_t> objectSnapshot() const;
+};
+
+/** @brief Gets the process wide statistics */
+Statistics& get() noexcept;
+
+/** @brief Gets the short name of a handled rtnetlink message type */
+std::string_view netlinkTypeName(uint16_t type) noexcept;
+
+/** @brief Records an rtnetlink message of the given type */
+inline void netlinkMsg(uint16_t type) noexcept
+{
+    if (type < get().netlinkMsgs.size())
+    {
+        add(get().netlinkMsgs[type]);
+    }
+}
+
+/** @class LiveObject
+ *  @brief Member of a D-Bus object class which keeps the count of live
+ *         objects of its kind up to date
+ */
+template <Object obj>
+class LiveObject
+{
+  public:
+    LiveObject() noexcept
+    {
+        add(get().objects[static_cast<size_t>(obj)]);
+    }
+    LiveObject(const LiveObject&) noexcept : LiveObject() {}
+    LiveObject& operator=(const LiveObject&) noexcept
+    {
+        return *this;
+    }
+    ~LiveObject()
+    {
+        get().objects[static_cast<size_t>(obj)].fetch_sub(
+            1, std::memory_order_relaxed);
+    }
+};
+
+/** @brief Bytes of heap in use by the process, including allocations made
+ *         by C libraries
+ */
+uint64_t heapBytes() noexcept;
+
+/** @brief Resident set size of the process in bytes */
+uint64_t residentBytes() noexcept;
+
+/** @class CountingSdBus
+ *  @brief sd-bus shim counting the signals we emit and the method calls we
+ *         make, including how long each call takes to be answered.
+ */
+class CountingSdBus : public sdbusplus::SdBusImpl
+{
+  public:
+    int sd_bus_call(sd_bus* bus, sd_bus_message* m, uint64_t usec,
+                    sd_bus_error* ret_error, sd_bus_message** reply) override;
+    int sd_bus_call_async(sd_bus* bus, sd_bus_slot** slot, sd_bus_message* m,
+                          sd_bus_message_handler_t callback, void* userdata,
+                          uint64_t usec) override;
+    int sd_bus_send(sd_bus* bus, sd_bus_message* m, uint64_t* cookie) override;
+    int sd_bus_emit_interfaces_added_strv(sd_bus* bus, const char* path,
+                                          char** interfaces) override;
+    int sd_bus_emit_interfaces_removed_strv(sd_bus* bus, const char* path,
+                                            char** interfaces) override;
+    int sd_bus_emit_object_added(sd_bus* bus, const char* path) override;
+    int sd_bus_emit_object_removed(sd_bus* bus, const char* path) override;
+    int sd_bus_emit_properties_changed_strv(sd_bus* bus, const char* path,
+                                            const char* interface,
+                                            const char** names) override;
+};
+
+/** @brief Connects to the default bus and routes it through the counting
+ *         shim, which must outlive the returned bus.
+ */
+sdbusplus::bus_t newDefaultBus(CountingSdBus& intf);
+
+} // namespace stats
+} // namespace network
+} // namespace phosphor
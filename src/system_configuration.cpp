@@ -25,7 +25,8 @@ static constexpr char propMatch[] =
     "arg0='org.freedesktop.hostname1'";
 
 SystemConfiguration::SystemConfiguration(
-    stdplus::PinnedRef<sdbusplus::bus_t> bus, stdplus::const_zstring objPath) :
+    stdplus::PinnedRef<sdbusplus::bus_t> bus, stdplus::const_zstring objPath,
+    Startup::Ticket&& ticket) :
     Iface(bus, objPath.c_str(), Iface::action::defer_emit), bus(bus),
     hostnamePropMatch(
         bus, propMatch,
@@ -51,15 +52,34 @@ SystemConfiguration::SystemConfiguration(
 {
     try
     {
-        std::variant<std::string> name;
         auto req =
             bus.get().new_method_call(HOSTNAMED_SVC, HOSTNAMED_OBJ,
                                       "org.freedesktop.DBus.Properties", "Get");
 
         req.append(HOSTNAMED_INTF, "Hostname");
-        auto reply = req.call();
-        reply.read(name);
-        SystemConfigIntf::hostName(std::get<std::string>(name), true);
+        hostnameCall.emplace(req.call_async(
+            [sc = stdplus::PinnedRef(*this),
+             ticket = std::move(ticket)](sdbusplus::message_t& m) mutable {
+                auto done = std::move(ticket);
+                if (m.is_method_error())
+                {
+                    lg2::error("Failed to get hostname: {ERROR}", "ERROR",
+                               m.get_error()->message);
+                    return;
+                }
+                try
+                {
+                    std::variant<std::string> name;
+                    m.read(name);
+                    sc.get().SystemConfigIntf::hostName(
+                        std::get<std::string>(name));
+                }
+                catch (const std::exception& e)
+                {
+                    lg2::error("Failed to parse hostname: {ERROR}", "ERROR",
+                               e);
+                }
+            }));
     }
     catch (const std::exception& e)
     {
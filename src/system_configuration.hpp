@@ -1,12 +1,15 @@
 #pragma once
+#include "startup.hpp"
 
 #include <sdbusplus/bus.hpp>
 #include <sdbusplus/bus/match.hpp>
 #include <sdbusplus/server/object.hpp>
+#include <sdbusplus/slot.hpp>
 #include <stdplus/pinned.hpp>
 #include <stdplus/zstring.hpp>
 #include <xyz/openbmc_project/Network/SystemConfiguration/server.hpp>
 
+#include <optional>
 #include <string>
 
 namespace phosphor
@@ -35,10 +38,11 @@ class SystemConfiguration : public Iface
     /** @brief Constructor to put object onto bus at a dbus path.
      *  @param[in] bus - Bus to attach to.
      *  @param[in] objPath - Path to attach at.
-     *  @param[in] parent - Parent object.
+     *  @param[in] ticket - Completed once the hostname has been fetched.
      */
     SystemConfiguration(stdplus::PinnedRef<sdbusplus::bus_t> bus,
-                        stdplus::const_zstring objPath);
+                        stdplus::const_zstring objPath,
+                        Startup::Ticket&& ticket = {});
 
     /** @brief set the hostname of the system.
      *  @param[in] name - host name of the system.
@@ -51,6 +55,9 @@ class SystemConfiguration : public Iface
 
     /** @brief Monitor for hostname changes */
     sdbusplus::bus::match_t hostnamePropMatch;
+
+    /** @brief Outstanding initial hostname query */
+    std::optional<sdbusplus::slot_t> hostnameCall;
 };
 
 } // namespace network
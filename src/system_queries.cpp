@@ -1,8 +1,11 @@
 #include "system_queries.hpp"
 
 #include "netlink.hpp"
+#include "netlink_msg.hpp"
+#include "rtnetlink.hpp"
 
 #include <linux/ethtool.h>
+#include <linux/if_link.h>
 #include <linux/rtnetlink.h>
 #include <linux/sockios.h>
 #include <net/if.h>
@@ -17,7 +20,9 @@
 #include <optional>
 #include <stdexcept>
 #include <string_view>
+#include <system_error>
 #include <unordered_set>
+#include <variant>
 
 namespace phosphor::network::system
 {
@@ -49,14 +54,16 @@ static ifreq executeIFReq(std::string_view ifname, unsigned long cmd,
     return ifr;
 }
 
-inline auto optionalIFReq(stdplus::zstring_view ifname, unsigned long long cmd,
+static_assert(IfName::capacity() == IFNAMSIZ - 1);
+
+inline auto optionalIFReq(std::string_view ifname, unsigned long long cmd,
                           std::string_view cmdname, auto&& complete,
                           void* data = nullptr)
 {
     ifreq ifr;
     std::optional<decltype(complete(ifr))> ret;
-    auto ukey = std::make_tuple(std::string(ifname), cmd);
-    static std::unordered_set<std::tuple<std::string, unsigned long long>>
+    auto ukey = std::make_tuple(IfName(ifname), cmd);
+    static std::unordered_set<std::tuple<IfName, unsigned long long>>
         unsupported;
     try
     {
@@ -68,7 +75,7 @@ inline auto optionalIFReq(stdplus::zstring_view ifname, unsigned long long cmd,
         {
             if (unsupported.find(ukey) == unsupported.end())
             {
-                unsupported.emplace(std::move(ukey));
+                unsupported.emplace(ukey);
                 lg2::info("{NET_IFREQ} not supported on {NET_INTF}",
                           "NET_IFREQ", cmdname, "NET_INTF", ifname);
             }
@@ -81,7 +88,7 @@ inline auto optionalIFReq(stdplus::zstring_view ifname, unsigned long long cmd,
     return ret;
 }
 
-EthInfo getEthInfo(stdplus::zstring_view ifname)
+EthInfo getEthInfo(std::string_view ifname)
 {
     ethtool_cmd edata = {};
     edata.cmd = ETHTOOL_GSET;
@@ -134,4 +141,149 @@ void deleteIntf(unsigned idx)
         });
 }
 
+/** @brief Sends a link request for the named link
+ *  @returns the errno of the request, 0 if it succeeded
+ */
+static int linkRequest(uint16_t type, std::string_view name,
+                       netlink::ReceiveCallback cb)
+{
+    ifinfomsg msg = {};
+    msg.ifi_family = AF_UNSPEC;
+    netlink::MsgBuilder b;
+    b.begin(type, NLM_F_REQUEST | NLM_F_ACK)
+        .data(msg)
+        .str(IFLA_IFNAME, name)
+        .end();
+    return netlink::performBatch(NETLINK_ROUTE, b.msgs(), cb).front();
+}
+
+static InterfaceInfo getLink(std::string_view name)
+{
+    std::optional<InterfaceInfo> ret;
+    auto err = linkRequest(RTM_GETLINK, name,
+                           [&](const nlmsghdr& hdr, std::string_view data) {
+        if (hdr.nlmsg_type == RTM_NEWLINK)
+        {
+            ret.emplace(netlink::intfFromRtm(data));
+        }
+    });
+    if (err != 0)
+    {
+        throw std::system_error(err, std::generic_category(),
+                                std::format("Failed to find `{}`", name));
+    }
+    if (!ret)
+    {
+        throw std::runtime_error(std::format("No link for `{}`", name));
+    }
+    return *ret;
+}
+
+InterfaceInfo createVLAN(unsigned parentIdx, std::string_view name,
+                         uint16_t id)
+{
+    ifinfomsg msg = {};
+    msg.ifi_family = AF_UNSPEC;
+    netlink::MsgBuilder b;
+    b.begin(RTM_NEWLINK, NLM_F_REQUEST | NLM_F_ACK | NLM_F_CREATE |
+                             NLM_F_EXCL | NLM_F_ECHO)
+        .data(msg)
+        .str(IFLA_IFNAME, name)
+        .attr(IFLA_LINK, uint32_t{parentIdx})
+        .nest(IFLA_LINKINFO)
+        .str(IFLA_INFO_KIND, "vlan")
+        .nest(IFLA_INFO_DATA)
+        .attr(IFLA_VLAN_ID, id)
+        .endNest()
+        .endNest()
+        .end();
+
+    std::optional<InterfaceInfo> ret;
+    auto err = netlink::performBatch(NETLINK_ROUTE, b.msgs(),
+                                     [&](const nlmsghdr& hdr,
+                                         std::string_view data) {
+        if (hdr.nlmsg_type == RTM_NEWLINK)
+        {
+            ret.emplace(netlink::intfFromRtm(data));
+        }
+    }).front();
+    if (err != 0)
+    {
+        throw std::system_error(err, std::generic_category(),
+                                std::format("Failed to create `{}`", name));
+    }
+    if (ret)
+    {
+        return *ret;
+    }
+
+    // Kernels before 6.1 ignore NLM_F_ECHO on links, so the link exists but
+    // has to be looked up. It is not left behind if that fails.
+    try
+    {
+        return getLink(name);
+    }
+    catch (...)
+    {
+        linkRequest(RTM_DELLINK, name,
+                    [](const nlmsghdr&, std::string_view) {});
+        throw;
+    }
+}
+
+static void routeMsg(netlink::MsgBuilder& b, uint16_t type, uint16_t flags,
+                     uint32_t seq, const RouteInfo& route)
+{
+    auto dst = route.dst.getAddr();
+    rtmsg rtm{};
+    rtm.rtm_family = std::holds_alternative<stdplus::In4Addr>(dst) ? AF_INET
+                                                                   : AF_INET6;
+    rtm.rtm_dst_len = route.dst.getPfx();
+    rtm.rtm_table = route.table < 256 ? route.table : RT_TABLE_UNSPEC;
+    rtm.rtm_protocol = route.protocol;
+    rtm.rtm_scope = route.scope;
+    rtm.rtm_type = route.type;
+    b.begin(type, NLM_F_REQUEST | NLM_F_ACK | flags, seq).data(rtm);
+    b.attr(RTA_TABLE, route.table);
+    if (rtm.rtm_dst_len != 0)
+    {
+        std::visit([&](const auto& a) { b.attr(RTA_DST, a); }, dst);
+    }
+    if (route.priority != 0)
+    {
+        b.attr(RTA_PRIORITY, route.priority);
+    }
+    if (!route.nexthops.empty())
+    {
+        const auto& nh = route.nexthops.front();
+        b.attr(RTA_OIF, uint32_t{nh.oif});
+        if (nh.gateway)
+        {
+            std::visit([&](const auto& a) { b.attr(RTA_GATEWAY, a); },
+                       *nh.gateway);
+        }
+    }
+    b.end();
+}
+
+std::vector<int> changeRoutes(std::span<const RouteInfo> del,
+                              std::span<const RouteInfo> add)
+{
+    netlink::MsgBuilder b;
+    uint32_t seq = 0;
+    for (const auto& route : del)
+    {
+        routeMsg(b, RTM_DELROUTE, 0, ++seq, route);
+    }
+    for (const auto& route : add)
+    {
+        routeMsg(b, RTM_NEWROUTE, NLM_F_CREATE | NLM_F_REPLACE, ++seq, route);
+    }
+    if (seq == 0)
+    {
+        return {};
+    }
+    return netlink::performBatch(NETLINK_ROUTE, b.msgs());
+}
+
 } // namespace phosphor::network::system
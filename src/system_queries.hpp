@@ -1,10 +1,10 @@
 #pragma once
 #include "types.hpp"
 
-#include <stdplus/zstring_view.hpp>
-
 #include <cstdint>
+#include <span>
 #include <string_view>
+#include <vector>
 
 namespace phosphor::network::system
 {
@@ -13,7 +13,7 @@ struct EthInfo
     bool autoneg;
     uint16_t speed;
 };
-EthInfo getEthInfo(stdplus::zstring_view ifname);
+EthInfo getEthInfo(std::string_view ifname);
 
 void setMTU(std::string_view ifname, unsigned mtu);
 
@@ -21,4 +21,20 @@ void setNICUp(std::string_view ifname, bool up);
 
 void deleteIntf(unsigned idx);
 
+/** @brief Creates a VLAN link on top of the parent
+ *  @returns the link as echoed back by the kernel, or looked up by name when
+ *           the kernel does not echo it, with its index
+ *  @throws std::system_error with the errno the kernel failed the request with
+ */
+InterfaceInfo createVLAN(unsigned parentIdx, std::string_view name,
+                         uint16_t id);
+
+/** @brief Removes and then adds routes, all in a single batch of rtnetlink
+ *         requests. Only the first nexthop of each route is used.
+ *  @returns the errno of each request, 0 if it succeeded, with the removals
+ *           ahead of the additions
+ */
+std::vector<int> changeRoutes(std::span<const RouteInfo> del,
+                              std::span<const RouteInfo> add);
+
 } // namespace phosphor::network::system
@@ -0,0 +1,28 @@
+#pragma once
+#include "config.h"
+
+/** @brief Static tracepoints on the netlink and manager hot paths, visible to
+ *         bpftrace, perf and systemtap as usdt:phosphor_networkd:<name>. They
+ *         compile to a single nop per site, and to nothing unless the usdt
+ *         option is enabled.
+ *
+ *  Probes and their arguments:
+ *    netlink_receive         fd, datagram bytes
+ *    netlink_msg             nlmsg_type, nlmsg_len, nlmsg_flags
+ *    netlink_{new,del}link   ifindex
+ *    netlink_{new,del}addr   ifindex
+ *    netlink_{new,del}neigh  ifindex
+ *    netlink_{new,del}route  ifindex of the default gateway
+ *    create_interface        ifindex
+ *    rename_interface        ifindex
+ *    write_config            ifindex
+ *    reload_start
+ *    reload_end              success, duration in us
+ */
+#ifdef HAVE_USDT
+#include <sys/sdt.h>
+
+#define NETWORKD_TRACE(...) STAP_PROBEV(phosphor_networkd, __VA_ARGS__)
+#else
+#define NETWORKD_TRACE(...) ((void)0)
+#endif
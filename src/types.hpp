@@ -4,10 +4,16 @@
 #include <stdplus/net/addr/ip.hpp>
 #include <stdplus/net/addr/subnet.hpp>
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
 #include <optional>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 namespace phosphor::network
 {
@@ -21,6 +27,71 @@ class DelayedExecutor
     virtual void setCallback(fu2::unique_function<void()>&& cb) = 0;
 };
 
+/** @class InlineString
+ *  @brief NUL terminated string of bounded length stored inline, so the
+ *         short names carried by netlink messages never touch the heap
+ */
+template <size_t N>
+class InlineString
+{
+  public:
+    static_assert(N <= UINT8_MAX);
+
+    constexpr InlineString() noexcept = default;
+    constexpr InlineString(std::string_view s)
+    {
+        if (s.size() > N)
+        {
+            throw std::length_error("String exceeds inline capacity");
+        }
+        std::copy(s.begin(), s.end(), buf.begin());
+        len = s.size();
+    }
+    constexpr InlineString(const char* s) : InlineString(std::string_view(s))
+    {}
+    constexpr InlineString(const std::string& s) :
+        InlineString(std::string_view(s))
+    {}
+
+    static constexpr size_t capacity() noexcept
+    {
+        return N;
+    }
+    constexpr size_t size() const noexcept
+    {
+        return len;
+    }
+    constexpr bool empty() const noexcept
+    {
+        return len == 0;
+    }
+    constexpr const char* c_str() const noexcept
+    {
+        return buf.data();
+    }
+    constexpr std::string_view view() const noexcept
+    {
+        return {buf.data(), len};
+    }
+    constexpr operator std::string_view() const noexcept
+    {
+        return view();
+    }
+
+    friend constexpr bool operator==(const InlineString& lhs,
+                                     std::string_view rhs) noexcept
+    {
+        return lhs.view() == rhs;
+    }
+
+  private:
+    std::array<char, N + 1> buf = {};
+    uint8_t len = 0;
+};
+
+/** @brief Interface names and link kinds, at most IFNAMSIZ less the NUL */
+using IfName = InlineString<15>;
+
 /** @class InterfaceInfo
  *  @brief Information about interfaces from the kernel
  */
@@ -29,11 +100,11 @@ struct InterfaceInfo
     unsigned short type;
     unsigned idx;
     unsigned flags;
-    std::optional<std::string> name = std::nullopt;
+    std::optional<IfName> name = std::nullopt;
     std::optional<stdplus::EtherAddr> mac = std::nullopt;
     std::optional<unsigned> mtu = std::nullopt;
     std::optional<unsigned> parent_idx = std::nullopt;
-    std::optional<std::string> kind = std::nullopt;
+    std::optional<IfName> kind = std::nullopt;
     std::optional<uint16_t> vlan_id = std::nullopt;
 
     constexpr bool operator==(const InterfaceInfo& rhs) const noexcept
@@ -45,6 +116,9 @@ struct InterfaceInfo
     }
 };
 
+// Passed from the parser to the manager by plain copies
+static_assert(std::is_trivially_copyable_v<InterfaceInfo>);
+
 /** @class AddressInfo
  *  @brief Information about a addresses from the kernel
  */
@@ -79,6 +153,33 @@ struct NeighborInfo
     }
 };
 
+/** @class RouteInfo
+ *  @brief Information about a route from the kernel, in any table
+ */
+struct RouteInfo
+{
+    struct NextHop
+    {
+        unsigned oif;
+        std::optional<stdplus::InAnyAddr> gateway = std::nullopt;
+        uint16_t weight = 1;
+
+        constexpr bool operator==(const NextHop&) const noexcept = default;
+    };
+
+    uint32_t table;
+    uint8_t protocol;
+    uint8_t scope;
+    uint8_t type;
+    stdplus::SubnetAny dst;
+    uint32_t priority = 0;
+    std::optional<stdplus::InAnyAddr> prefsrc = std::nullopt;
+    /** @brief A single entry unless the route is multipath */
+    std::vector<NextHop> nexthops = {};
+
+    bool operator==(const RouteInfo&) const noexcept = default;
+};
+
 /** @brief Contains all of the object information about the interface */
 struct AllIntfInfo
 {
@@ -90,3 +191,13 @@ struct AllIntfInfo
 };
 
 } // namespace phosphor::network
+
+template <size_t N>
+struct std::hash<phosphor::network::InlineString<N>>
+{
+    inline size_t operator()(
+        const phosphor::network::InlineString<N>& s) const noexcept
+    {
+        return std::hash<std::string_view>{}(s);
+    }
+};
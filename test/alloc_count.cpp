@@ -0,0 +1,121 @@
+#include "alloc_count.hpp"
+
+#include <malloc.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace phosphor::network
+{
+
+static std::atomic<size_t> allocs = 0;
+static std::atomic<size_t> bytes = 0;
+
+size_t allocations() noexcept
+{
+    return allocs.load(std::memory_order_relaxed);
+}
+
+size_t liveBytes() noexcept
+{
+    return bytes.load(std::memory_order_relaxed);
+}
+
+static void* countedAlloc(size_t size, size_t align)
+{
+    allocs.fetch_add(1, std::memory_order_relaxed);
+    if (size == 0)
+    {
+        size = 1;
+    }
+    void* ret = nullptr;
+    if (align <= alignof(std::max_align_t))
+    {
+        ret = std::malloc(size);
+    }
+    else
+    {
+        ret = std::aligned_alloc(align, (size + align - 1) & ~(align - 1));
+    }
+    if (ret == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    bytes.fetch_add(malloc_usable_size(ret), std::memory_order_relaxed);
+    return ret;
+}
+
+static void countedFree(void* ptr) noexcept
+{
+    if (ptr != nullptr)
+    {
+        bytes.fetch_sub(malloc_usable_size(ptr), std::memory_order_relaxed);
+    }
+    std::free(ptr);
+}
+
+} // namespace phosphor::network
+
+using phosphor::network::countedAlloc;
+using phosphor::network::countedFree;
+
+void* operator new(size_t size)
+{
+    return countedAlloc(size, alignof(std::max_align_t));
+}
+
+void* operator new[](size_t size)
+{
+    return countedAlloc(size, alignof(std::max_align_t));
+}
+
+void* operator new(size_t size, std::align_val_t align)
+{
+    return countedAlloc(size, static_cast<size_t>(align));
+}
+
+void* operator new[](size_t size, std::align_val_t align)
+{
+    return countedAlloc(size, static_cast<size_t>(align));
+}
+
+void operator delete(void* ptr) noexcept
+{
+    countedFree(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    countedFree(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    countedFree(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+    countedFree(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+    countedFree(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept
+{
+    countedFree(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept
+{
+    countedFree(ptr);
+}
+
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept
+{
+    countedFree(ptr);
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include <cstddef>
+
+namespace phosphor::network
+{
+
+/** @brief Number of heap allocations made by the process so far. Global
+ *         operator new is replaced by alloc_count.cpp to count them, so only
+ *         binaries linking it directly can use this.
+ */
+size_t allocations() noexcept;
+
+/** @brief Bytes currently held by operator new allocations, as reported by
+ *         malloc_usable_size() so allocator rounding is included.
+ */
+size_t liveBytes() noexcept;
+
+} // namespace phosphor::network
@@ -0,0 +1,957 @@
+#include "fake_kernel.hpp"
+
+#include "netlink.hpp"
+#include "netlink_msg.hpp"
+#include "rtnetlink.hpp"
+#include "util.hpp"
+
+#include <linux/if_link.h>
+#include <net/if_arp.h>
+
+#include <stdplus/raw.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <format>
+#include <stdexcept>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace phosphor::network::system
+{
+
+using std::literals::string_view_literals::operator""sv;
+
+static FakeKernel* kernel = nullptr;
+
+FakeKernel::FakeKernel()
+{
+    if (kernel != nullptr)
+    {
+        throw std::logic_error("FakeKernel already running");
+    }
+    kernel = this;
+}
+
+FakeKernel::~FakeKernel()
+{
+    kernel = nullptr;
+}
+
+FakeKernel* FakeKernel::current() noexcept
+{
+    return kernel;
+}
+
+static uint8_t familyOf(const stdplus::InAnyAddr& addr)
+{
+    return std::visit(
+        [](const auto& a) -> uint8_t {
+            if constexpr (std::is_same_v<std::decay_t<decltype(a)>,
+                                         stdplus::In4Addr>)
+            {
+                return AF_INET;
+            }
+            else
+            {
+                return AF_INET6;
+            }
+        },
+        addr);
+}
+
+static void addrAttr(netlink::MsgBuilder& b, uint16_t type,
+                     const stdplus::InAnyAddr& addr)
+{
+    std::visit([&](const auto& a) { b.attr(type, a); }, addr);
+}
+
+static std::string addrKey(const AddressInfo& info)
+{
+    return std::format("{}/{}", info.ifidx, stdplus::toStr(info.ifaddr));
+}
+
+static std::string routeKey(const FakeKernel::Route& route)
+{
+    return std::format("{}/{}/{}/{}/{}", route.family, route.table,
+                       route.dst ? stdplus::toStr(*route.dst) : "default",
+                       route.dstLen, route.priority);
+}
+
+static std::string neighKey(const NeighborInfo& info)
+{
+    return std::format("{}/{}", info.ifidx, stdplus::toStr(info.addr.value()));
+}
+
+static unsigned addrGroup(uint8_t family)
+{
+    return family == AF_INET ? RTNLGRP_IPV4_IFADDR : RTNLGRP_IPV6_IFADDR;
+}
+
+static unsigned routeGroup(uint8_t family)
+{
+    return family == AF_INET ? RTNLGRP_IPV4_ROUTE : RTNLGRP_IPV6_ROUTE;
+}
+
+static void linkMsg(netlink::MsgBuilder& b, uint16_t type, uint16_t flags,
+                    uint32_t seq, uint32_t pid, const InterfaceInfo& info)
+{
+    ifinfomsg ifi{};
+    ifi.ifi_family = AF_UNSPEC;
+    ifi.ifi_type = info.type;
+    ifi.ifi_index = info.idx;
+    ifi.ifi_flags = info.flags;
+    ifi.ifi_change = ~0u;
+    b.begin(type, flags, seq, pid).data(ifi);
+    if (info.name)
+    {
+        b.str(IFLA_IFNAME, *info.name);
+    }
+    if (info.mac)
+    {
+        b.attr(IFLA_ADDRESS, *info.mac);
+    }
+    if (info.mtu)
+    {
+        b.attr(IFLA_MTU, *info.mtu);
+    }
+    if (info.parent_idx)
+    {
+        b.attr(IFLA_LINK, *info.parent_idx);
+    }
+    if (info.kind)
+    {
+        b.nest(IFLA_LINKINFO).str(IFLA_INFO_KIND, *info.kind);
+        if (info.vlan_id)
+        {
+            b.nest(IFLA_INFO_DATA).attr(IFLA_VLAN_ID, *info.vlan_id).endNest();
+        }
+        b.endNest();
+    }
+    b.end();
+}
+
+static void addrMsg(netlink::MsgBuilder& b, uint16_t type, uint16_t flags,
+                    uint32_t seq, uint32_t pid, const AddressInfo& info)
+{
+    auto addr = info.ifaddr.getAddr();
+    ifaddrmsg ifa{};
+    ifa.ifa_family = familyOf(addr);
+    ifa.ifa_prefixlen = info.ifaddr.getPfx();
+    ifa.ifa_flags = info.flags & 0xff;
+    ifa.ifa_scope = info.scope;
+    ifa.ifa_index = info.ifidx;
+    b.begin(type, flags, seq, pid).data(ifa);
+    addrAttr(b, IFA_ADDRESS, addr);
+    if (ifa.ifa_family == AF_INET)
+    {
+        addrAttr(b, IFA_LOCAL, addr);
+    }
+    b.attr(IFA_FLAGS, info.flags).end();
+}
+
+static void routeMsg(netlink::MsgBuilder& b, uint16_t type, uint16_t flags,
+                     uint32_t seq, uint32_t pid, const FakeKernel::Route& route)
+{
+    rtmsg rtm{};
+    rtm.rtm_family = route.family;
+    rtm.rtm_dst_len = route.dstLen;
+    rtm.rtm_table = route.table;
+    rtm.rtm_protocol = route.protocol;
+    rtm.rtm_scope = route.scope;
+    rtm.rtm_type = route.type;
+    b.begin(type, flags, seq, pid).data(rtm);
+    b.attr(RTA_TABLE, uint32_t{route.table});
+    if (route.dst)
+    {
+        addrAttr(b, RTA_DST, *route.dst);
+    }
+    if (route.gateway)
+    {
+        addrAttr(b, RTA_GATEWAY, *route.gateway);
+    }
+    if (route.oif != 0)
+    {
+        b.attr(RTA_OIF, route.oif);
+    }
+    if (route.priority != 0)
+    {
+        b.attr(RTA_PRIORITY, route.priority);
+    }
+    b.end();
+}
+
+static void neighMsg(netlink::MsgBuilder& b, uint16_t type, uint16_t flags,
+                     uint32_t seq, uint32_t pid, const NeighborInfo& info)
+{
+    ndmsg ndm{};
+    ndm.ndm_family = familyOf(info.addr.value());
+    ndm.ndm_ifindex = info.ifidx;
+    ndm.ndm_state = info.state;
+    ndm.ndm_type = RTN_UNICAST;
+    b.begin(type, flags, seq, pid).data(ndm);
+    addrAttr(b, NDA_DST, *info.addr);
+    if (info.mac)
+    {
+        b.attr(NDA_LLADDR, *info.mac);
+    }
+    b.end();
+}
+
+static FakeKernel::Route routeFromRtm(std::string_view msg)
+{
+    const auto& rtm = netlink::extractRtData<rtmsg>(msg);
+    FakeKernel::Route ret{.family = rtm.rtm_family,
+                          .table = rtm.rtm_table,
+                          .protocol = rtm.rtm_protocol,
+                          .scope = rtm.rtm_scope,
+                          .type = rtm.rtm_type,
+                          .dstLen = rtm.rtm_dst_len};
+    while (!msg.empty())
+    {
+        auto [hdr, data] = netlink::extractRtAttr(msg);
+        switch (hdr.rta_type)
+        {
+            case RTA_TABLE:
+                ret.table = stdplus::raw::copyFrom<uint32_t>(data);
+                break;
+            case RTA_DST:
+                ret.dst = addrFromBuf(ret.family, data);
+                break;
+            case RTA_GATEWAY:
+                ret.gateway = addrFromBuf(ret.family, data);
+                break;
+            case RTA_OIF:
+                ret.oif = stdplus::raw::copyFrom<unsigned>(data);
+                break;
+            case RTA_PRIORITY:
+                ret.priority = stdplus::raw::copyFrom<uint32_t>(data);
+                break;
+        }
+    }
+    return ret;
+}
+
+void FakeKernel::addLink(const InterfaceInfo& info)
+{
+    newLink(info, {});
+}
+
+void FakeKernel::removeLink(unsigned idx)
+{
+    delLink(idx, {});
+}
+
+void FakeKernel::addAddress(const AddressInfo& info)
+{
+    newAddr(info, {});
+}
+
+void FakeKernel::removeAddress(const AddressInfo& info)
+{
+    delAddr(info, {});
+}
+
+void FakeKernel::addRoute(const Route& route)
+{
+    newRoute(route, {});
+}
+
+void FakeKernel::removeRoute(const Route& route)
+{
+    delRoute(route, {});
+}
+
+void FakeKernel::addNeighbor(const NeighborInfo& info)
+{
+    newNeigh(info, {});
+}
+
+void FakeKernel::removeNeighbor(const NeighborInfo& info)
+{
+    delNeigh(info, {});
+}
+
+void FakeKernel::setRcvbuf(int fd, size_t bytes)
+{
+    socket(fd).rcvbuf = bytes;
+}
+
+void FakeKernel::overflow(int fd)
+{
+    auto& sock = socket(fd);
+    sock.dropped++;
+    sock.overrun = true;
+}
+
+void FakeKernel::truncateNext(int fd, size_t size)
+{
+    socket(fd).truncate = size;
+}
+
+size_t FakeKernel::pending(int fd) const
+{
+    return socket(fd).queue.size();
+}
+
+size_t FakeKernel::dropped(int fd) const
+{
+    return socket(fd).dropped;
+}
+
+bool FakeKernel::owns(int fd) const noexcept
+{
+    return sockets.contains(fd);
+}
+
+void FakeKernel::open(int fd)
+{
+    sockets.insert_or_assign(fd, Socket{.portId = nextPortId++});
+}
+
+void FakeKernel::close(int fd)
+{
+    sockets.erase(fd);
+}
+
+int FakeKernel::bind(int fd, const sockaddr_nl& addr)
+{
+    auto& sock = socket(fd);
+    if (addr.nl_family != AF_NETLINK)
+    {
+        errno = EINVAL;
+        return -1;
+    }
+    if (addr.nl_pid != 0)
+    {
+        sock.portId = addr.nl_pid;
+    }
+    // Legacy group bits map to the group numbers one above them
+    for (unsigned i = 0; i < 32; ++i)
+    {
+        if (addr.nl_groups & (1u << i))
+        {
+            sock.groups.insert(i + 1);
+        }
+    }
+    return 0;
+}
+
+int FakeKernel::addMembership(int fd, unsigned group)
+{
+    if (group == 0 || group > __RTNLGRP_MAX)
+    {
+        errno = EINVAL;
+        return -1;
+    }
+    socket(fd).groups.insert(group);
+    return 0;
+}
+
+ssize_t FakeKernel::sendmsg(int fd, std::string_view data)
+{
+    socket(fd);
+    auto msgs = data;
+    while (!msgs.empty())
+    {
+        if (msgs.size() < sizeof(nlmsghdr))
+        {
+            errno = EINVAL;
+            return -1;
+        }
+        auto hdr = stdplus::raw::copyFrom<nlmsghdr>(msgs);
+        if (hdr.nlmsg_len < sizeof(hdr) || hdr.nlmsg_len > msgs.size())
+        {
+            errno = EINVAL;
+            return -1;
+        }
+        auto payload = msgs.substr(NLMSG_HDRLEN,
+                                   hdr.nlmsg_len - NLMSG_HDRLEN);
+        msgs.remove_prefix(
+            std::min<size_t>(msgs.size(), NLMSG_ALIGN(hdr.nlmsg_len)));
+        if (!(hdr.nlmsg_flags & NLM_F_REQUEST))
+        {
+            continue;
+        }
+
+        Origin origin{.fd = fd,
+                      .seq = hdr.nlmsg_seq,
+                      .flags = hdr.nlmsg_flags};
+        int err = 0;
+        try
+        {
+            switch (hdr.nlmsg_type)
+            {
+                case RTM_GETLINK:
+                case RTM_GETADDR:
+                case RTM_GETROUTE:
+                case RTM_GETNEIGH:
+                    if ((hdr.nlmsg_flags & NLM_F_DUMP) == NLM_F_DUMP)
+                    {
+                        // Dumps end in NLMSG_DONE instead of an ack
+                        dump(origin, hdr.nlmsg_type);
+                        continue;
+                    }
+                    if (hdr.nlmsg_type == RTM_GETLINK)
+                    {
+                        err = getLink(payload, origin);
+                    }
+                    else
+                    {
+                        err = -EOPNOTSUPP;
+                    }
+                    break;
+                case RTM_NEWLINK:
+                case RTM_DELLINK:
+                    err = handleLink(hdr, payload, origin);
+                    break;
+                case RTM_NEWADDR:
+                case RTM_DELADDR:
+                    err = handleAddr(hdr, payload, origin);
+                    break;
+                case RTM_NEWROUTE:
+                case RTM_DELROUTE:
+                    err = handleRoute(hdr, payload, origin);
+                    break;
+                case RTM_NEWNEIGH:
+                case RTM_DELNEIGH:
+                    err = handleNeigh(hdr, payload, origin);
+                    break;
+                default:
+                    err = -EOPNOTSUPP;
+                    break;
+            }
+        }
+        catch (const std::exception&)
+        {
+            err = -EINVAL;
+        }
+        if (err != 0 || (hdr.nlmsg_flags & NLM_F_ACK))
+        {
+            reply(origin, hdr, err);
+        }
+    }
+    return data.size();
+}
+
+ssize_t FakeKernel::recvmsg(int fd, msghdr& msg)
+{
+    auto& sock = socket(fd);
+    if (sock.overrun)
+    {
+        sock.overrun = false;
+        errno = ENOBUFS;
+        return -1;
+    }
+    if (sock.queue.empty())
+    {
+        errno = EAGAIN;
+        return -1;
+    }
+    auto datagram = std::move(sock.queue.front());
+    sock.queue.pop_front();
+    sock.queued -= datagram.size();
+
+    if (msg.msg_name != nullptr && msg.msg_namelen >= sizeof(sockaddr_nl))
+    {
+        sockaddr_nl from{};
+        from.nl_family = AF_NETLINK;
+        std::memcpy(msg.msg_name, &from, sizeof(from));
+        msg.msg_namelen = sizeof(from);
+    }
+    msg.msg_flags = 0;
+
+    auto size = datagram.size();
+    if (sock.truncate)
+    {
+        size = std::min(size, *sock.truncate);
+        sock.truncate.reset();
+    }
+    size_t copied = 0;
+    for (size_t i = 0; i < msg.msg_iovlen && copied < size; ++i)
+    {
+        auto n = std::min(size - copied, msg.msg_iov[i].iov_len);
+        std::memcpy(msg.msg_iov[i].iov_base, datagram.data() + copied, n);
+        copied += n;
+    }
+    if (copied < datagram.size())
+    {
+        msg.msg_flags |= MSG_TRUNC;
+    }
+    return copied;
+}
+
+uint32_t FakeKernel::portId(const Origin& origin) const
+{
+    return origin.fd < 0 ? 0 : socket(origin.fd).portId;
+}
+
+FakeKernel::Socket& FakeKernel::socket(int fd)
+{
+    auto it = sockets.find(fd);
+    if (it == sockets.end())
+    {
+        throw std::invalid_argument("Not a fake netlink socket");
+    }
+    return it->second;
+}
+
+const FakeKernel::Socket& FakeKernel::socket(int fd) const
+{
+    return const_cast<FakeKernel&>(*this).socket(fd);
+}
+
+void FakeKernel::enqueue(Socket& sock, std::string&& datagram, bool multicast)
+{
+    // Only notifications are lost to a full receive buffer, the kernel holds
+    // back replies until there is room for them
+    if (multicast && sock.queued + datagram.size() > sock.rcvbuf)
+    {
+        sock.dropped++;
+        sock.overrun = true;
+        return;
+    }
+    sock.queued += datagram.size();
+    sock.queue.push_back(std::move(datagram));
+}
+
+void FakeKernel::notify(unsigned group, std::string_view msg,
+                        const Origin& origin)
+{
+    for (auto& [fd, sock] : sockets)
+    {
+        // The requester gets its echo instead of the multicast copy
+        if (fd == origin.fd && (origin.flags & NLM_F_ECHO))
+        {
+            enqueue(sock, std::string(msg), false);
+        }
+        else if (sock.groups.contains(group))
+        {
+            enqueue(sock, std::string(msg), true);
+        }
+    }
+}
+
+void FakeKernel::reply(const Origin& origin, const nlmsghdr& req, int error)
+{
+    auto& sock = socket(origin.fd);
+    nlmsgerr err{};
+    err.error = error;
+    err.msg = req;
+    netlink::MsgBuilder b;
+    b.begin(NLMSG_ERROR, error == 0 ? NLM_F_CAPPED : 0, origin.seq,
+            sock.portId)
+        .data(err)
+        .end();
+    enqueue(sock, std::string(b.msgs()), false);
+}
+
+int FakeKernel::getLink(std::string_view data, const Origin& origin)
+{
+    auto req = netlink::intfFromRtm(data);
+    auto it = links.find(req.idx);
+    if (req.idx == 0 && req.name)
+    {
+        it = std::find_if(links.begin(), links.end(), [&](const auto& l) {
+            return l.second.name == req.name;
+        });
+    }
+    if (it == links.end())
+    {
+        return -ENODEV;
+    }
+    auto& sock = socket(origin.fd);
+    netlink::MsgBuilder b;
+    linkMsg(b, RTM_NEWLINK, 0, origin.seq, sock.portId, it->second);
+    enqueue(sock, std::string(b.msgs()), false);
+    return 0;
+}
+
+int FakeKernel::handleLink(const nlmsghdr& hdr, std::string_view data,
+                           const Origin& origin)
+{
+    auto change = stdplus::raw::copyFrom<ifinfomsg>(data).ifi_change;
+    auto req = netlink::intfFromRtm(data);
+    auto it = links.find(req.idx);
+    if (req.idx == 0 && req.name)
+    {
+        it = std::find_if(links.begin(), links.end(), [&](const auto& l) {
+            return l.second.name == req.name;
+        });
+    }
+
+    if (hdr.nlmsg_type == RTM_DELLINK)
+    {
+        if (it == links.end())
+        {
+            return -ENODEV;
+        }
+        delLink(it->first, origin);
+        return 0;
+    }
+
+    if (it != links.end())
+    {
+        if (hdr.nlmsg_flags & NLM_F_EXCL)
+        {
+            return -EEXIST;
+        }
+        auto info = it->second;
+        info.flags = (info.flags & ~change) | (req.flags & change);
+        if (req.name)
+        {
+            info.name = req.name;
+        }
+        if (req.mac)
+        {
+            info.mac = req.mac;
+        }
+        if (req.mtu)
+        {
+            info.mtu = req.mtu;
+        }
+        newLink(info, origin);
+        return 0;
+    }
+
+    if (!(hdr.nlmsg_flags & NLM_F_CREATE))
+    {
+        return -ENODEV;
+    }
+    if (!req.name || !req.kind)
+    {
+        return -EINVAL;
+    }
+    if (req.kind == "vlan"sv)
+    {
+        if (!req.vlan_id || !req.parent_idx)
+        {
+            return -EINVAL;
+        }
+        auto parent = links.find(*req.parent_idx);
+        if (parent == links.end())
+        {
+            return -ENODEV;
+        }
+        if (!req.mac)
+        {
+            req.mac = parent->second.mac;
+        }
+        if (!req.mtu)
+        {
+            req.mtu = parent->second.mtu;
+        }
+    }
+    if (req.idx == 0)
+    {
+        req.idx = nextIdx;
+    }
+    if (req.type == 0)
+    {
+        req.type = ARPHRD_ETHER;
+    }
+    newLink(req, origin);
+    return 0;
+}
+
+int FakeKernel::handleAddr(const nlmsghdr& hdr, std::string_view data,
+                           const Origin& origin)
+{
+    auto req = netlink::addrFromRtm(data);
+    if (!links.contains(req.ifidx))
+    {
+        return -ENODEV;
+    }
+    auto it = addrs.find(addrKey(req));
+    if (hdr.nlmsg_type == RTM_DELADDR)
+    {
+        if (it == addrs.end())
+        {
+            return -EADDRNOTAVAIL;
+        }
+        delAddr(it->second, origin);
+        return 0;
+    }
+    if (it != addrs.end() && (hdr.nlmsg_flags & NLM_F_EXCL))
+    {
+        return -EEXIST;
+    }
+    if (it == addrs.end() && !(hdr.nlmsg_flags & NLM_F_CREATE))
+    {
+        return -ENOENT;
+    }
+    newAddr(req, origin);
+    return 0;
+}
+
+int FakeKernel::handleRoute(const nlmsghdr& hdr, std::string_view data,
+                            const Origin& origin)
+{
+    auto req = routeFromRtm(data);
+    if (req.oif != 0 && !links.contains(req.oif))
+    {
+        return -ENODEV;
+    }
+    auto it = routes.find(routeKey(req));
+    if (hdr.nlmsg_type == RTM_DELROUTE)
+    {
+        if (it == routes.end())
+        {
+            return -ESRCH;
+        }
+        delRoute(it->second, origin);
+        return 0;
+    }
+    if (it != routes.end() && (hdr.nlmsg_flags & NLM_F_EXCL))
+    {
+        return -EEXIST;
+    }
+    if (it == routes.end() && !(hdr.nlmsg_flags & NLM_F_CREATE))
+    {
+        return -ENOENT;
+    }
+    newRoute(req, origin);
+    return 0;
+}
+
+int FakeKernel::handleNeigh(const nlmsghdr& hdr, std::string_view data,
+                            const Origin& origin)
+{
+    auto req = netlink::neighFromRtm(data);
+    if (!req.addr)
+    {
+        return -EINVAL;
+    }
+    if (!links.contains(req.ifidx))
+    {
+        return -ENODEV;
+    }
+    auto it = neighs.find(neighKey(req));
+    if (hdr.nlmsg_type == RTM_DELNEIGH)
+    {
+        if (it == neighs.end())
+        {
+            return -ENOENT;
+        }
+        delNeigh(it->second, origin);
+        return 0;
+    }
+    if (it != neighs.end() && (hdr.nlmsg_flags & NLM_F_EXCL))
+    {
+        return -EEXIST;
+    }
+    if (it == neighs.end() && !(hdr.nlmsg_flags & NLM_F_CREATE))
+    {
+        return -ENOENT;
+    }
+    newNeigh(req, origin);
+    return 0;
+}
+
+void FakeKernel::dump(const Origin& origin, uint16_t type)
+{
+    auto& sock = socket(origin.fd);
+    uint16_t flags = NLM_F_MULTI | (dumpInterrupted ? NLM_F_DUMP_INTR : 0);
+
+    std::vector<std::string> msgs;
+    netlink::MsgBuilder b;
+    auto add = [&](auto&& build) {
+        b.clear();
+        build();
+        msgs.emplace_back(b.msgs());
+    };
+    switch (type)
+    {
+        case RTM_GETLINK:
+            for (const auto& [_, info] : links)
+            {
+                add([&] {
+                    linkMsg(b, RTM_NEWLINK, flags, origin.seq, sock.portId,
+                            info);
+                });
+            }
+            break;
+        case RTM_GETADDR:
+            for (const auto& [_, info] : addrs)
+            {
+                add([&] {
+                    addrMsg(b, RTM_NEWADDR, flags, origin.seq, sock.portId,
+                            info);
+                });
+            }
+            break;
+        case RTM_GETROUTE:
+            for (const auto& [_, route] : routes)
+            {
+                add([&] {
+                    routeMsg(b, RTM_NEWROUTE, flags, origin.seq, sock.portId,
+                             route);
+                });
+            }
+            break;
+        case RTM_GETNEIGH:
+            for (const auto& [_, info] : neighs)
+            {
+                add([&] {
+                    neighMsg(b, RTM_NEWNEIGH, flags, origin.seq, sock.portId,
+                             info);
+                });
+            }
+            break;
+    }
+    add([&] { b.done(origin.seq, sock.portId); });
+    if (dumpInterrupted)
+    {
+        // The flag is carried by the NLMSG_DONE as well
+        auto& done = msgs.back();
+        uint16_t doneFlags = NLM_F_MULTI | NLM_F_DUMP_INTR;
+        std::memcpy(done.data() + offsetof(nlmsghdr, nlmsg_flags), &doneFlags,
+                    sizeof(doneFlags));
+    }
+
+    // Pack as many messages as fit into each datagram, at least one
+    std::string datagram;
+    for (auto& msg : msgs)
+    {
+        if (!datagram.empty() &&
+            datagram.size() + msg.size() > dumpDatagramSize)
+        {
+            enqueue(sock, std::move(datagram), false);
+            datagram.clear();
+        }
+        datagram += msg;
+    }
+    enqueue(sock, std::move(datagram), false);
+}
+
+void FakeKernel::newLink(const InterfaceInfo& info, const Origin& origin)
+{
+    links.insert_or_assign(info.idx, info);
+    nextIdx = std::max(nextIdx, info.idx + 1);
+    netlink::MsgBuilder b;
+    linkMsg(b, RTM_NEWLINK, 0, origin.seq, portId(origin), info);
+    auto notifier = origin;
+    if (!linkEcho)
+    {
+        notifier.flags &= ~NLM_F_ECHO;
+    }
+    notify(RTNLGRP_LINK, b.msgs(), notifier);
+}
+
+void FakeKernel::delLink(unsigned idx, const Origin& origin)
+{
+    auto it = links.find(idx);
+    if (it == links.end())
+    {
+        return;
+    }
+
+    // Stacked devices go away with their lower device
+    std::vector<unsigned> children;
+    for (const auto& [cidx, info] : links)
+    {
+        if (info.parent_idx == idx && cidx != idx)
+        {
+            children.push_back(cidx);
+        }
+    }
+    for (auto cidx : children)
+    {
+        delLink(cidx, origin);
+    }
+
+    std::vector<AddressInfo> oldAddrs;
+    for (const auto& [_, info] : addrs)
+    {
+        if (info.ifidx == idx)
+        {
+            oldAddrs.push_back(info);
+        }
+    }
+    for (const auto& info : oldAddrs)
+    {
+        delAddr(info, origin);
+    }
+    std::vector<NeighborInfo> oldNeighs;
+    for (const auto& [_, info] : neighs)
+    {
+        if (info.ifidx == idx)
+        {
+            oldNeighs.push_back(info);
+        }
+    }
+    for (const auto& info : oldNeighs)
+    {
+        delNeigh(info, origin);
+    }
+    // Routes through the link are flushed without notifications
+    std::erase_if(routes, [&](const auto& r) { return r.second.oif == idx; });
+
+    auto info = std::move(it->second);
+    links.erase(it);
+    netlink::MsgBuilder b;
+    linkMsg(b, RTM_DELLINK, 0, origin.seq, portId(origin), info);
+    notify(RTNLGRP_LINK, b.msgs(), origin);
+}
+
+void FakeKernel::newAddr(const AddressInfo& info, const Origin& origin)
+{
+    addrs.insert_or_assign(addrKey(info), info);
+    netlink::MsgBuilder b;
+    addrMsg(b, RTM_NEWADDR, 0, origin.seq, portId(origin), info);
+    notify(addrGroup(familyOf(info.ifaddr.getAddr())), b.msgs(), origin);
+}
+
+void FakeKernel::delAddr(const AddressInfo& info, const Origin& origin)
+{
+    if (addrs.erase(addrKey(info)) == 0)
+    {
+        return;
+    }
+    netlink::MsgBuilder b;
+    addrMsg(b, RTM_DELADDR, 0, origin.seq, portId(origin), info);
+    notify(addrGroup(familyOf(info.ifaddr.getAddr())), b.msgs(), origin);
+}
+
+void FakeKernel::newRoute(const Route& route, const Origin& origin)
+{
+    routes.insert_or_assign(routeKey(route), route);
+    netlink::MsgBuilder b;
+    routeMsg(b, RTM_NEWROUTE, 0, origin.seq, portId(origin), route);
+    notify(routeGroup(route.family), b.msgs(), origin);
+}
+
+void FakeKernel::delRoute(const Route& route, const Origin& origin)
+{
+    if (routes.erase(routeKey(route)) == 0)
+    {
+        return;
+    }
+    netlink::MsgBuilder b;
+    routeMsg(b, RTM_DELROUTE, 0, origin.seq, portId(origin), route);
+    notify(routeGroup(route.family), b.msgs(), origin);
+}
+
+void FakeKernel::newNeigh(const NeighborInfo& info, const Origin& origin)
+{
+    neighs.insert_or_assign(neighKey(info), info);
+    netlink::MsgBuilder b;
+    neighMsg(b, RTM_NEWNEIGH, 0, origin.seq, portId(origin), info);
+    notify(RTNLGRP_NEIGH, b.msgs(), origin);
+}
+
+void FakeKernel::delNeigh(const NeighborInfo& info, const Origin& origin)
+{
+    if (neighs.erase(neighKey(info)) == 0)
+    {
+        return;
+    }
+    netlink::MsgBuilder b;
+    neighMsg(b, RTM_DELNEIGH, 0, origin.seq, portId(origin), info);
+    notify(RTNLGRP_NEIGH, b.msgs(), origin);
+}
+
+} // namespace phosphor::network::system
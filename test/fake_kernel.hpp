@@ -0,0 +1,203 @@
+#pragma once
+#include "types.hpp"
+
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <sys/socket.h>
+
+#include <stdplus/net/addr/ip.hpp>
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace phosphor::network::system
+{
+
+/** @class FakeKernel
+ *  @brief In-process rtnetlink kernel for the tests. While one exists, every
+ *         NETLINK_ROUTE socket opened by the process talks to it instead of
+ *         the mock link dump responder.
+ *
+ *  It keeps link, address, route and neighbor tables, answers dumps split
+ *  across NLM_F_MULTI datagrams, applies RTM_NEW* / RTM_DEL* requests and
+ *  sends the resulting notifications to the sockets subscribed to their
+ *  multicast groups. Faults like receive buffer overruns, truncated reads and
+ *  interrupted dumps can be injected.
+ */
+class FakeKernel
+{
+  public:
+    struct Route
+    {
+        uint8_t family;
+        uint8_t table = RT_TABLE_MAIN;
+        uint8_t protocol = RTPROT_STATIC;
+        uint8_t scope = RT_SCOPE_UNIVERSE;
+        uint8_t type = RTN_UNICAST;
+        uint8_t dstLen = 0;
+        std::optional<stdplus::InAnyAddr> dst = std::nullopt;
+        std::optional<stdplus::InAnyAddr> gateway = std::nullopt;
+        unsigned oif = 0;
+        uint32_t priority = 0;
+
+        constexpr bool operator==(const Route&) const noexcept = default;
+    };
+
+    FakeKernel();
+    ~FakeKernel();
+    FakeKernel(const FakeKernel&) = delete;
+    FakeKernel& operator=(const FakeKernel&) = delete;
+
+    /** @brief The kernel serving the netlink sockets, if any */
+    static FakeKernel* current() noexcept;
+
+    /** @brief Kernel side changes, notified to the subscribed sockets */
+    void addLink(const InterfaceInfo& info);
+    void removeLink(unsigned idx);
+    void addAddress(const AddressInfo& info);
+    void removeAddress(const AddressInfo& info);
+    void addRoute(const Route& route);
+    void removeRoute(const Route& route);
+    void addNeighbor(const NeighborInfo& info);
+    void removeNeighbor(const NeighborInfo& info);
+
+    /** @brief Read access to the tables */
+    inline const auto& getLinks() const noexcept
+    {
+        return links;
+    }
+    inline const auto& getAddresses() const noexcept
+    {
+        return addrs;
+    }
+    inline const auto& getRoutes() const noexcept
+    {
+        return routes;
+    }
+    inline const auto& getNeighbors() const noexcept
+    {
+        return neighs;
+    }
+
+    /** @brief Largest datagram a dump is split into */
+    inline void setDumpDatagramSize(size_t size) noexcept
+    {
+        dumpDatagramSize = size;
+    }
+
+    /** @brief Marks every dump message with NLM_F_DUMP_INTR, as if the
+     *         tables kept changing while being dumped
+     */
+    inline void setDumpInterrupted(bool intr) noexcept
+    {
+        dumpInterrupted = intr;
+    }
+
+    /** @brief Whether new links are echoed back to a requester asking for
+     *         it, which kernels before 6.1 do not do
+     */
+    inline void setLinkEcho(bool echo) noexcept
+    {
+        linkEcho = echo;
+    }
+
+    /** @brief Receive buffer size of the sockets, past which notifications
+     *         are dropped and the next read fails with ENOBUFS
+     */
+    void setRcvbuf(int fd, size_t bytes);
+
+    /** @brief Loses a notification on the socket as if its receive buffer
+     *         had overrun, failing its next read with ENOBUFS
+     */
+    void overflow(int fd);
+
+    /** @brief Truncates the next datagram read from the socket to at most
+     *         the given size, flagging the read with MSG_TRUNC
+     */
+    void truncateNext(int fd, size_t size);
+
+    /** @brief Number of datagrams waiting to be read on the socket */
+    size_t pending(int fd) const;
+
+    /** @brief Number of notifications dropped on the socket so far */
+    size_t dropped(int fd) const;
+
+    /** @brief Socket operations routed here by the syscall mocks */
+    bool owns(int fd) const noexcept;
+    void open(int fd);
+    void close(int fd);
+    int bind(int fd, const sockaddr_nl& addr);
+    int addMembership(int fd, unsigned group);
+    ssize_t sendmsg(int fd, std::string_view data);
+    ssize_t recvmsg(int fd, msghdr& msg);
+
+  private:
+    struct Socket
+    {
+        uint32_t portId;
+        std::set<unsigned> groups;
+        std::deque<std::string> queue;
+        size_t queued = 0;
+        size_t rcvbuf = 212992;
+        size_t dropped = 0;
+        bool overrun = false;
+        std::optional<size_t> truncate;
+    };
+
+    /** @brief Where a request came from, for acks, echoes and notifications
+     */
+    struct Origin
+    {
+        int fd = -1;
+        uint32_t seq = 0;
+        uint16_t flags = 0;
+    };
+
+    /** @brief The tables, keyed the way the kernel identifies entries */
+    std::map<unsigned, InterfaceInfo> links;
+    std::map<std::string, AddressInfo> addrs;
+    std::map<std::string, Route> routes;
+    std::map<std::string, NeighborInfo> neighs;
+    unsigned nextIdx = 1;
+
+    std::unordered_map<int, Socket> sockets;
+    uint32_t nextPortId = 1000;
+    size_t dumpDatagramSize = 4096;
+    bool dumpInterrupted = false;
+    bool linkEcho = true;
+
+    Socket& socket(int fd);
+    const Socket& socket(int fd) const;
+    uint32_t portId(const Origin& origin) const;
+    void enqueue(Socket& sock, std::string&& datagram, bool multicast);
+    void notify(unsigned group, std::string_view msg, const Origin& origin);
+    void reply(const Origin& origin, const nlmsghdr& req, int error);
+
+    int getLink(std::string_view data, const Origin& origin);
+    int handleLink(const nlmsghdr& hdr, std::string_view data,
+                   const Origin& origin);
+    int handleAddr(const nlmsghdr& hdr, std::string_view data,
+                   const Origin& origin);
+    int handleRoute(const nlmsghdr& hdr, std::string_view data,
+                    const Origin& origin);
+    int handleNeigh(const nlmsghdr& hdr, std::string_view data,
+                    const Origin& origin);
+    void dump(const Origin& origin, uint16_t type);
+
+    void newLink(const InterfaceInfo& info, const Origin& origin);
+    void delLink(unsigned idx, const Origin& origin);
+    void newAddr(const AddressInfo& info, const Origin& origin);
+    void delAddr(const AddressInfo& info, const Origin& origin);
+    void newRoute(const Route& route, const Origin& origin);
+    void delRoute(const Route& route, const Origin& origin);
+    void newNeigh(const NeighborInfo& info, const Origin& origin);
+    void delNeigh(const NeighborInfo& info, const Origin& origin);
+};
+
+} // namespace phosphor::network::system
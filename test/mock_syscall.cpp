@@ -1,11 +1,13 @@
 #include "mock_syscall.hpp"
 
+#include "fake_kernel.hpp"
 #include "util.hpp"
 
 #include <arpa/inet.h>
 #include <dlfcn.h>
 #include <linux/netlink.h>
 #include <linux/rtnetlink.h>
+#include <linux/sockios.h>
 #include <net/ethernet.h>
 #include <net/if.h>
 #include <netinet/in.h>
@@ -16,6 +18,7 @@
 
 #include <stdplus/raw.hpp>
 
+#include <algorithm>
 #include <cstdarg>
 #include <cstdio>
 #include <cstring>
@@ -24,18 +27,23 @@
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 std::map<int, std::queue<std::string>> mock_rtnetlinks;
 
 using phosphor::network::InterfaceInfo;
+using phosphor::network::system::FakeKernel;
 
 std::map<std::string, InterfaceInfo> mock_if;
 
+std::map<int, std::string> mock_sent;
+
 void phosphor::network::system::mock_clear()
 {
     mock_rtnetlinks.clear();
     mock_if.clear();
+    mock_sent.clear();
 }
 
 void phosphor::network::system::mock_addIF(const InterfaceInfo& info)
@@ -54,6 +62,21 @@ void phosphor::network::system::mock_addIF(const InterfaceInfo& info)
     mock_if.emplace(info.name.value(), info);
 }
 
+void phosphor::network::system::mock_tapSend(int fd)
+{
+    mock_sent[fd];
+}
+
+std::string phosphor::network::system::mock_takeSent(int fd)
+{
+    auto it = mock_sent.find(fd);
+    if (it == mock_sent.end())
+    {
+        throw std::invalid_argument("Socket not tapped");
+    }
+    return std::exchange(it->second, {});
+}
+
 void validateMsgHdr(const struct msghdr* msg)
 {
     if (msg->msg_namelen != sizeof(sockaddr_nl))
@@ -189,6 +212,15 @@ int ioctl(int fd, unsigned long int request, ...)
         req->ifr_mtu = *it->second.mtu;
         return 0;
     }
+    else if (request == SIOCETHTOOL)
+    {
+        // Mocked interfaces report no link settings, leaving the caller's
+        // zeroed ethtool_cmd untouched
+        if (mock_if.find(req->ifr_name) != mock_if.end())
+        {
+            return 0;
+        }
+    }
 
     static auto real_ioctl =
         reinterpret_cast<decltype(&ioctl)>(dlsym(RTLD_NEXT, "ioctl"));
@@ -205,20 +237,69 @@ int socket(int domain, int type, int protocol)
         fprintf(stderr, "Netlink sockets must be RAW\n");
         abort();
     }
-    if (domain == AF_NETLINK && protocol == NETLINK_ROUTE)
+    if (fd >= 0 && domain == AF_NETLINK && protocol == NETLINK_ROUTE)
     {
-        mock_rtnetlinks[fd] = {};
+        if (auto kernel = FakeKernel::current(); kernel != nullptr)
+        {
+            kernel->open(fd);
+        }
+        else
+        {
+            mock_rtnetlinks[fd] = {};
+        }
     }
     return fd;
 }
 
+int bind(int fd, const struct sockaddr* addr, socklen_t len)
+{
+    if (auto kernel = FakeKernel::current(); kernel && kernel->owns(fd))
+    {
+        if (len < sizeof(sockaddr_nl))
+        {
+            errno = EINVAL;
+            return -1;
+        }
+        return kernel->bind(fd, *reinterpret_cast<const sockaddr_nl*>(addr));
+    }
+
+    static auto real_bind =
+        reinterpret_cast<decltype(&bind)>(dlsym(RTLD_NEXT, "bind"));
+    return real_bind(fd, addr, len);
+}
+
+int setsockopt(int fd, int level, int optname, const void* optval,
+               socklen_t optlen)
+{
+    if (auto kernel = FakeKernel::current(); kernel && kernel->owns(fd))
+    {
+        if (level == SOL_NETLINK && optname == NETLINK_ADD_MEMBERSHIP &&
+            optlen >= sizeof(unsigned))
+        {
+            return kernel->addMembership(
+                fd, *reinterpret_cast<const unsigned*>(optval));
+        }
+        // Buffer sizes and the like have no effect on the fake sockets
+        return 0;
+    }
+
+    static auto real_setsockopt = reinterpret_cast<decltype(&setsockopt)>(
+        dlsym(RTLD_NEXT, "setsockopt"));
+    return real_setsockopt(fd, level, optname, optval, optlen);
+}
+
 int close(int fd)
 {
+    if (auto kernel = FakeKernel::current(); kernel && kernel->owns(fd))
+    {
+        kernel->close(fd);
+    }
     auto it = mock_rtnetlinks.find(fd);
     if (it != mock_rtnetlinks.end())
     {
         mock_rtnetlinks.erase(it);
     }
+    mock_sent.erase(fd);
 
     static auto real_close =
         reinterpret_cast<decltype(&close)>(dlsym(RTLD_NEXT, "close"));
@@ -227,12 +308,37 @@ int close(int fd)
 
 ssize_t sendmsg(int sockfd, const struct msghdr* msg, int flags)
 {
+    if (auto kernel = FakeKernel::current(); kernel && kernel->owns(sockfd))
+    {
+        std::string data;
+        for (size_t i = 0; i < msg->msg_iovlen; ++i)
+        {
+            data.append(reinterpret_cast<char*>(msg->msg_iov[i].iov_base),
+                        msg->msg_iov[i].iov_len);
+        }
+        return kernel->sendmsg(sockfd, data);
+    }
+
     auto it = mock_rtnetlinks.find(sockfd);
     if (it == mock_rtnetlinks.end())
     {
         static auto real_sendmsg =
             reinterpret_cast<decltype(&sendmsg)>(dlsym(RTLD_NEXT, "sendmsg"));
-        return real_sendmsg(sockfd, msg, flags);
+        auto ret = real_sendmsg(sockfd, msg, flags);
+        auto tap = mock_sent.find(sockfd);
+        if (ret > 0 && tap != mock_sent.end())
+        {
+            size_t left = ret;
+            for (size_t i = 0; i < msg->msg_iovlen && left > 0; ++i)
+            {
+                auto len = std::min(left, msg->msg_iov[i].iov_len);
+                tap->second.append(
+                    reinterpret_cast<const char*>(msg->msg_iov[i].iov_base),
+                    len);
+                left -= len;
+            }
+        }
+        return ret;
     }
     auto& msgs = it->second;
 
@@ -265,6 +371,11 @@ ssize_t sendmsg(int sockfd, const struct msghdr* msg, int flags)
 
 ssize_t recvmsg(int sockfd, struct msghdr* msg, int flags)
 {
+    if (auto kernel = FakeKernel::current(); kernel && kernel->owns(sockfd))
+    {
+        return kernel->recvmsg(sockfd, *msg);
+    }
+
     auto it = mock_rtnetlinks.find(sockfd);
     if (it == mock_rtnetlinks.end())
     {
@@ -1,6 +1,8 @@
 #pragma once
 #include "system_queries.hpp"
 
+#include <string>
+
 namespace phosphor::network::system
 {
 /** @brief Clears out the interfaces and IPs configured for mocking */
@@ -8,4 +10,10 @@ void mock_clear();
 
 /** @brief Adds an interface definition to the mock system */
 void mock_addIF(const InterfaceInfo& info);
+
+/** @brief Starts recording the bytes successfully sent on a socket */
+void mock_tapSend(int fd);
+
+/** @brief Returns and clears the bytes recorded for a tapped socket */
+std::string mock_takeSent(int fd);
 } // namespace phosphor::network::system
@@ -0,0 +1,76 @@
+#include "apply_tracker.hpp"
+#include "statistics.hpp"
+
+#include <chrono>
+#include <numeric>
+
+#include <gtest/gtest.h>
+
+namespace phosphor
+{
+namespace network
+{
+
+static uint64_t applied(stats::ApplyOp op)
+{
+    auto hist = stats::get().applyLatency[static_cast<size_t>(op)].snapshot();
+    return std::accumulate(hist.begin(), hist.end(), uint64_t{0});
+}
+
+TEST(TestApplyTracker, ConfirmMatching)
+{
+    ApplyTracker tracker;
+    auto addrs = applied(stats::ApplyOp::Address);
+    auto gws = applied(stats::ApplyOp::Gateway);
+
+    stdplus::SubnetAny addr{stdplus::In4Addr{192, 168, 1, 2}, 24};
+    stdplus::InAnyAddr gw{stdplus::In4Addr{192, 168, 1, 1}};
+    tracker.expect(stats::ApplyOp::Address, 2, addr);
+    tracker.expect(stats::ApplyOp::Gateway, 2, gw);
+
+    // Wrong interface or value must not complete the change
+    tracker.confirm(3, addr);
+    tracker.confirm(2, stdplus::SubnetAny{addr.getAddr(), 16});
+    EXPECT_EQ(addrs, applied(stats::ApplyOp::Address));
+
+    tracker.confirm(2, addr);
+    EXPECT_EQ(addrs + 1, applied(stats::ApplyOp::Address));
+    tracker.confirm(2, addr);
+    EXPECT_EQ(addrs + 1, applied(stats::ApplyOp::Address));
+
+    tracker.confirm(2, gw);
+    EXPECT_EQ(gws + 1, applied(stats::ApplyOp::Gateway));
+}
+
+TEST(TestApplyTracker, Forget)
+{
+    ApplyTracker tracker;
+    auto addrs = applied(stats::ApplyOp::Address);
+
+    stdplus::SubnetAny addr{stdplus::In6Addr{0xfd, 0, 0, 0, 1}, 64};
+    tracker.expect(stats::ApplyOp::Address, 4, addr);
+    tracker.forget(4);
+    tracker.confirm(4, addr);
+    EXPECT_EQ(addrs, applied(stats::ApplyOp::Address));
+}
+
+TEST(TestHistogram, SloBuckets)
+{
+    using std::chrono::seconds;
+    stats::Histogram hist;
+    hist.record(seconds(5));
+    hist.record(seconds(12));
+    hist.record(seconds(25));
+    hist.record(seconds(60));
+
+    // Each lands in its own bucket, the last one only past 2^25us
+    auto counts = hist.snapshot();
+    ASSERT_EQ(stats::Histogram::buckets, counts.size());
+    EXPECT_EQ(1, counts[23]);
+    EXPECT_EQ(1, counts[24]);
+    EXPECT_EQ(1, counts[25]);
+    EXPECT_EQ(1, counts[26]);
+}
+
+} // namespace network
+} // namespace phosphor
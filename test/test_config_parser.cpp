@@ -1,4 +1,5 @@
 #include "config_parser.hpp"
+#include "statistics.hpp"
 
 #include <phosphor-logging/elog-errors.hpp>
 #include <stdplus/fd/atomic.hpp>
@@ -178,6 +179,29 @@ TEST_F(TestConfigParser, WriteConfigFile)
     ValidateSectionMap();
 }
 
+TEST_F(TestConfigParser, WriteUnchangedConfigFileSkipped)
+{
+    WriteSampleFile();
+    parser.setFile(filename);
+
+    auto& counters = stats::get();
+    auto written = stats::load(counters.configsWritten);
+    auto skipped = stats::load(counters.configsSkipped);
+    parser.writeFile();
+    EXPECT_EQ(written + 1, stats::load(counters.configsWritten));
+    EXPECT_EQ(skipped, stats::load(counters.configsSkipped));
+
+    parser.writeFile();
+    EXPECT_EQ(written + 1, stats::load(counters.configsWritten));
+    EXPECT_EQ(skipped + 1, stats::load(counters.configsSkipped));
+
+    parser.map["Network"].emplace_back()["DHCP"].emplace_back("no");
+    parser.writeFile();
+    EXPECT_EQ(written + 2, stats::load(counters.configsWritten));
+    parser.setFile(filename);
+    EXPECT_EQ("no", *parser.map.getLastValueString("Network", "DHCP"));
+}
+
 TEST_F(TestConfigParser, Perf)
 {
     GTEST_SKIP();
@@ -0,0 +1,467 @@
+#include "config_parser.hpp"
+#include "mock_syscall.hpp"
+#include "network_manager.hpp"
+
+#include <fcntl.h>
+#include <net/if.h>
+#include <net/if_arp.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/server/manager.hpp>
+#include <stdplus/gtest/tmp.hpp>
+#include <stdplus/numeric/str.hpp>
+#include <stdplus/pinned.hpp>
+#include <stdplus/print.hpp>
+#include <stdplus/raw.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <variant>
+
+#include <gtest/gtest.h>
+
+namespace phosphor
+{
+namespace network
+{
+
+constexpr char objRoot[] = "/xyz/openbmc_test/network";
+
+/** @brief Messages and bytes written by a bus connection */
+struct Traffic
+{
+    size_t methodCalls = 0;
+    size_t replies = 0;
+    size_t signals = 0;
+    size_t bytes = 0;
+};
+
+/** @brief Splits the raw bytes written to a bus socket back into messages
+ *         using the fixed part of the D-Bus wire header
+ */
+static Traffic parseTraffic(std::string_view data)
+{
+    constexpr char endian = std::endian::native == std::endian::little ? 'l'
+                                                                        : 'B';
+    constexpr size_t fixedHdr = 16;
+
+    Traffic ret;
+    ret.bytes = data.size();
+    while (!data.empty())
+    {
+        if (data.size() < fixedHdr || data[0] != endian)
+        {
+            throw std::runtime_error("Malformed D-Bus message header");
+        }
+        auto bodyLen = stdplus::raw::copyFrom<uint32_t>(data.substr(4));
+        auto fieldsLen = stdplus::raw::copyFrom<uint32_t>(data.substr(12));
+        size_t len = fixedHdr + ((fieldsLen + 7) & ~size_t{7}) + bodyLen;
+        switch (data[1])
+        {
+            case SD_BUS_MESSAGE_METHOD_CALL:
+                ret.methodCalls++;
+                break;
+            case SD_BUS_MESSAGE_METHOD_RETURN:
+            case SD_BUS_MESSAGE_METHOD_ERROR:
+                ret.replies++;
+                break;
+            case SD_BUS_MESSAGE_SIGNAL:
+                ret.signals++;
+                break;
+        }
+        data.remove_prefix(std::min(len, data.size()));
+    }
+    return ret;
+}
+
+/** @class DBusDaemon
+ *  @brief A dbus-daemon private to a single test, so that nothing else on
+ *         the bus adds to or observes the traffic being measured
+ */
+class DBusDaemon
+{
+  public:
+    explicit DBusDaemon(const std::filesystem::path& dir)
+    {
+        auto conf = dir / "bus.conf";
+        std::ofstream(conf) << std::format(
+            R"(<!DOCTYPE busconfig PUBLIC
+ "-//freedesktop//DTD D-BUS Bus Configuration 1.0//EN"
+ "http://www.freedesktop.org/standards/dbus/1.0/busconfig.dtd">
+<busconfig>
+  <type>session</type>
+  <listen>unix:path={}</listen>
+  <auth>EXTERNAL</auth>
+  <policy context="default">
+    <allow send_destination="*"/>
+    <allow own="*"/>
+  </policy>
+</busconfig>
+)",
+            (dir / "bus").native());
+
+        const char* daemon = std::getenv("DBUS_DAEMON");
+        if (daemon == nullptr)
+        {
+            daemon = "dbus-daemon";
+        }
+        int out[2];
+        if (pipe2(out, O_CLOEXEC) != 0)
+        {
+            throw std::system_error(errno, std::generic_category(), "pipe");
+        }
+        auto confArg = std::format("--config-file={}", conf.native());
+        pid = fork();
+        if (pid == 0)
+        {
+            dup2(out[1], STDOUT_FILENO);
+            execlp(daemon, daemon, confArg.c_str(), "--nofork",
+                   "--print-address", nullptr);
+            _exit(127);
+        }
+        ::close(out[1]);
+
+        char c;
+        while (::read(out[0], &c, 1) == 1 && c != '\n')
+        {
+            address.push_back(c);
+        }
+        ::close(out[0]);
+        if (pid < 0 || address.empty())
+        {
+            throw std::runtime_error("Failed to start dbus-daemon");
+        }
+    }
+
+    ~DBusDaemon()
+    {
+        if (pid > 0)
+        {
+            kill(pid, SIGTERM);
+            waitpid(pid, nullptr, 0);
+        }
+    }
+
+    DBusDaemon(const DBusDaemon&) = delete;
+    DBusDaemon& operator=(const DBusDaemon&) = delete;
+
+    sdbusplus::bus_t connect() const
+    {
+        sd_bus* b = nullptr;
+        if (sd_bus_new(&b) < 0 || sd_bus_set_address(b, address.c_str()) < 0 ||
+            sd_bus_set_bus_client(b, 1) < 0 || sd_bus_start(b) < 0)
+        {
+            sd_bus_unref(b);
+            throw std::runtime_error("Failed to connect to dbus-daemon");
+        }
+        return sdbusplus::bus_t(b, std::false_type{});
+    }
+
+  private:
+    pid_t pid = -1;
+    std::string address;
+};
+
+/** @brief Runs the reload when the test settles instead of on a timer */
+struct SettleExecutor : DelayedExecutor
+{
+    SettleExecutor() = default;
+    SettleExecutor(SettleExecutor&&) = delete;
+
+    bool scheduled = false;
+    fu2::unique_function<void()> cb;
+
+    void schedule() override
+    {
+        scheduled = true;
+    }
+    void setCallback(fu2::unique_function<void()>&& cb) override
+    {
+        this->cb = std::move(cb);
+    }
+};
+
+struct TrafficManager : Manager
+{
+    using Manager::handleAdminState;
+    using Manager::Manager;
+};
+
+/** @brief The budget checked in for a measurement: a fixed margin over the
+ *         counts, and a tenth over the bytes
+ */
+static Traffic withMargin(const Traffic& t)
+{
+    return Traffic{.methodCalls = t.methodCalls + 1,
+                   .replies = t.replies,
+                   .signals = t.signals + 2,
+                   .bytes = t.bytes + t.bytes / 10};
+}
+
+/** @brief Rewrites the budgets of a section of the file in place, keeping
+ *         its comments
+ */
+static void writeBudget(const std::filesystem::path& path,
+                        std::string_view section, const Traffic& budget)
+{
+    std::ifstream in(path);
+    std::string out, line;
+    bool inSection = false;
+    while (std::getline(in, line))
+    {
+        if (line.starts_with('['))
+        {
+            inSection = line == std::format("[{}]", section);
+        }
+        else if (inSection && line.starts_with("MethodCalls="))
+        {
+            line = std::format("MethodCalls={}", budget.methodCalls);
+        }
+        else if (inSection && line.starts_with("Signals="))
+        {
+            line = std::format("Signals={}", budget.signals);
+        }
+        else if (inSection && line.starts_with("Bytes="))
+        {
+            line = std::format("Bytes={}", budget.bytes);
+        }
+        out += line;
+        out += '\n';
+    }
+    in.close();
+    std::ofstream(path) << out;
+}
+
+/** @class DBusTraffic
+ *  @brief Measures what the manager writes to the bus for each operation and
+ *         compares it against the budgets in dbus_traffic.budgets, named
+ *         after the test case. Only the manager's own connection is counted:
+ *         the signals it emits, its replies and the calls it makes to other
+ *         services.
+ */
+class DBusTraffic : public stdplus::gtest::TestWithTmp
+{
+  protected:
+    DBusDaemon dbus;
+    stdplus::Pinned<sdbusplus::bus_t> bus;
+    stdplus::Pinned<sdbusplus::bus_t> client;
+    SettleExecutor reload;
+    std::optional<sdbusplus::server::manager_t> objManager;
+    std::optional<TrafficManager> manager;
+
+    DBusTraffic() :
+        dbus(CaseTmpDir()), bus(dbus.connect()), client(dbus.connect())
+    {
+        // Wait out the Hello so the connection setup is not counted
+        bus.get_unique_name();
+        client.get_unique_name();
+        system::mock_tapSend(sd_bus_get_fd(bus.get()));
+    }
+
+    static InterfaceInfo ether(unsigned idx, unsigned flags)
+    {
+        return InterfaceInfo{
+            .type = ARPHRD_ETHER,
+            .idx = idx,
+            .flags = flags,
+            .name = std::format("eth{}", idx - 1),
+            .mac = stdplus::EtherAddr{2, 0, 0, 0, 0, uint8_t(idx)},
+            .mtu = 1500};
+    }
+
+    void startManager(unsigned intfs)
+    {
+        objManager.emplace(bus, objRoot);
+        manager.emplace(bus, reload, objRoot, CaseTmpDir());
+        for (unsigned i = 1; i <= intfs; ++i)
+        {
+            manager->addInterface(ether(i, IFF_UP | IFF_RUNNING));
+            manager->handleAdminState("managed", i);
+        }
+        // Seal the tracker the way main() does, so that startup completes
+        // and publishes its diagnostics properties
+        manager->getStartup().seal();
+        settle();
+    }
+
+    /** @brief Dispatches everything outstanding on both connections,
+     *         including the reload, until the bus goes quiet
+     */
+    void settle()
+    {
+        while (true)
+        {
+            bool busy = false;
+            for (auto b : {bus.get(), client.get()})
+            {
+                while (sd_bus_process(b, nullptr) > 0)
+                {
+                    busy = true;
+                }
+                sd_bus_flush(b);
+            }
+            if (reload.scheduled)
+            {
+                reload.scheduled = false;
+                reload.cb();
+                busy = true;
+            }
+            if (busy)
+            {
+                continue;
+            }
+            std::array<pollfd, 2> fds{
+                pollfd{.fd = sd_bus_get_fd(bus.get()), .events = POLLIN},
+                pollfd{.fd = sd_bus_get_fd(client.get()),
+                       .events = POLLIN}};
+            if (poll(fds.data(), fds.size(), 100) <= 0)
+            {
+                return;
+            }
+        }
+    }
+
+    /** @brief Calls a method on the manager from another connection */
+    template <typename... Args>
+    void call(std::string_view path, const char* intf, const char* method,
+              Args&&... args)
+    {
+        auto m = client.new_method_call(bus.get_unique_name(),
+                                              std::string(path).c_str(), intf,
+                                              method);
+        (m.append(std::forward<Args>(args)), ...);
+        std::optional<std::string> error;
+        bool done = false;
+        auto slot = m.call_async([&](sdbusplus::message_t& reply) {
+            done = true;
+            if (reply.is_method_error())
+            {
+                error = reply.get_error()->name;
+            }
+        });
+        settle();
+        ASSERT_TRUE(done) << method;
+        ASSERT_FALSE(error) << method << ": " << *error;
+    }
+
+    std::string intfPath(unsigned idx)
+    {
+        return std::format("{}/eth{}", objRoot, idx - 1);
+    }
+
+    Traffic take()
+    {
+        settle();
+        return parseTraffic(
+            system::mock_takeSent(sd_bus_get_fd(bus.get())));
+    }
+
+    /** @brief Checks the traffic since the last take() against the budget
+     *         of the running test
+     */
+    void expectWithinBudget()
+    {
+        auto traffic = take();
+        std::string_view name =
+            testing::UnitTest::GetInstance()->current_test_info()->name();
+        stdplus::print(stderr,
+                       "{}: {} method calls, {} replies, {} signals, "
+                       "{} bytes\n",
+                       name, traffic.methodCalls, traffic.replies,
+                       traffic.signals, traffic.bytes);
+
+        const char* path = std::getenv("DBUS_TRAFFIC_BUDGETS");
+        ASSERT_NE(nullptr, path) << "DBUS_TRAFFIC_BUDGETS is not set";
+        config::Parser budgets(path);
+        ASSERT_TRUE(budgets.getFileExists()) << path;
+        auto expected = withMargin(traffic);
+        if (std::getenv("DBUS_TRAFFIC_UPDATE") != nullptr)
+        {
+            writeBudget(path, name, expected);
+            return;
+        }
+        auto budget = [&](std::string_view key) -> size_t {
+            auto val = budgets.map.getLastValueString(name, key);
+            if (val == nullptr)
+            {
+                ADD_FAILURE() << "No " << key << " budget for " << name;
+                return 0;
+            }
+            return stdplus::StrToInt<10, size_t>{}(*val);
+        };
+
+        // A budget must hold what was measured, and must not leave more than
+        // twice the margin unused or it no longer catches regressions. Run
+        // with DBUS_TRAFFIC_UPDATE=1 to check in the measured values.
+        auto check = [&](std::string_view key, size_t measured, size_t max) {
+            auto val = budget(key);
+            EXPECT_LE(measured, val) << key << " over budget";
+            EXPECT_LE(val - std::min(val, measured), 2 * (max - measured))
+                << key << " budget is stale, lower it to " << max;
+        };
+        check("MethodCalls", traffic.methodCalls, expected.methodCalls);
+        check("Signals", traffic.signals, expected.signals);
+        check("Bytes", traffic.bytes, expected.bytes);
+    }
+};
+
+TEST_F(DBusTraffic, Startup)
+{
+    startManager(16);
+    expectWithinBudget();
+}
+
+TEST_F(DBusTraffic, CreateVlan)
+{
+    startManager(1);
+    take();
+    call(objRoot, "xyz.openbmc_project.Network.VLAN.Create", "VLAN", "eth0",
+         uint32_t{10});
+    expectWithinBudget();
+}
+
+TEST_F(DBusTraffic, AddIP)
+{
+    startManager(1);
+    take();
+    call(intfPath(1), "xyz.openbmc_project.Network.IP.Create", "IP",
+         "xyz.openbmc_project.Network.IP.Protocol.IPv4", "10.0.0.5",
+         uint8_t{24}, "");
+    expectWithinBudget();
+}
+
+TEST_F(DBusTraffic, SetGateway)
+{
+    startManager(1);
+    take();
+    call(intfPath(1), "org.freedesktop.DBus.Properties", "Set",
+         "xyz.openbmc_project.Network.EthernetInterface", "DefaultGateway",
+         std::variant<std::string>("10.0.0.1"));
+    expectWithinBudget();
+}
+
+TEST_F(DBusTraffic, LinkFlap)
+{
+    startManager(1);
+    take();
+    manager->addInterface(ether(1, IFF_UP));
+    manager->addInterface(ether(1, IFF_UP | IFF_RUNNING));
+    expectWithinBudget();
+}
+
+} // namespace network
+} // namespace phosphor
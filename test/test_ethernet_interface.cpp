@@ -208,6 +208,43 @@ TEST_F(TestEthernetInterface, addGateway6)
     EXPECT_EQ(interface.defaultGateway6(), "");
 }
 
+TEST_F(TestEthernetInterface, BulkNeighbors)
+{
+    EXPECT_THROW(interface.neighbors({{"10.0.0.1", "02:00:00:00:00:01"},
+                                      {"10.0.0.2", "bad"}}),
+                 InvalidArgument);
+    EXPECT_THROW(interface.neighbors({{"10.0.0.1", "02:00:00:00:00:01"},
+                                      {"10.0.0.1", "02:00:00:00:00:02"}}),
+                 InvalidArgument);
+    EXPECT_TRUE(interface.staticNeighbors.empty());
+
+    // The whole batch is written and reloaded once
+    EXPECT_CALL(manager.mockReload, schedule()).Times(1);
+    auto paths = interface.neighbors({{"10.0.0.2", "02:00:00:00:00:02"},
+                                      {"fe80::1", "02:00:00:00:00:03"},
+                                      {"10.0.0.1", "02:00:00:00:00:01"}});
+    testing::Mock::VerifyAndClearExpectations(&manager.mockReload);
+    ASSERT_EQ(3, paths.size());
+    EXPECT_EQ(paths[2], interface.neighbor("10.0.0.1", "02:00:00:00:00:01"));
+    config::Parser config(config::pathForIntfConf(confDir, "test0"));
+    EXPECT_EQ(3, config.map.getValueStrings("Neighbor", "Address").size());
+
+    std::vector<std::tuple<std::string, std::string>> expected{
+        {"10.0.0.1", "02:00:00:00:00:01"},
+        {"10.0.0.2", "02:00:00:00:00:02"},
+        {"fe80::1", "02:00:00:00:00:03"}};
+    EXPECT_EQ(expected, interface.exportNeighbors());
+
+    // Re-importing an export only applies what differs
+    std::get<1>(expected[1]) = "02:00:00:00:00:04";
+    EXPECT_CALL(manager.mockReload, schedule()).Times(1);
+    interface.neighbors(expected);
+    testing::Mock::VerifyAndClearExpectations(&manager.mockReload);
+    EXPECT_EQ(expected, interface.exportNeighbors());
+    EXPECT_CALL(manager.mockReload, schedule()).Times(0);
+    interface.neighbors(expected);
+}
+
 TEST_F(TestEthernetInterface, DHCPEnabled)
 {
     EXPECT_CALL(manager.mockReload, schedule())
@@ -0,0 +1,371 @@
+#include "fake_kernel.hpp"
+#include "netlink.hpp"
+#include "netlink_msg.hpp"
+#include "rtnetlink.hpp"
+#include "system_queries.hpp"
+
+#include <linux/if_addr.h>
+#include <linux/if_link.h>
+#include <net/if.h>
+#include <net/if_arp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <stdplus/raw.hpp>
+
+#include <cerrno>
+#include <format>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace phosphor::network::system
+{
+
+using netlink::MsgBuilder;
+
+class FakeKernelTest : public testing::Test
+{
+  protected:
+    FakeKernel kernel;
+    std::vector<int> fds;
+
+    ~FakeKernelTest() override
+    {
+        for (auto fd : fds)
+        {
+            ::close(fd);
+        }
+    }
+
+    int open(uint32_t groups = 0)
+    {
+        int fd = ::socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+        EXPECT_LE(0, fd);
+        fds.push_back(fd);
+        sockaddr_nl local{};
+        local.nl_family = AF_NETLINK;
+        local.nl_groups = groups;
+        EXPECT_EQ(0, ::bind(fd, reinterpret_cast<sockaddr*>(&local),
+                            sizeof(local)));
+        return fd;
+    }
+
+    void send(int fd, std::string_view msgs)
+    {
+        iovec iov{};
+        iov.iov_base = const_cast<char*>(msgs.data());
+        iov.iov_len = msgs.size();
+        msghdr hdr{};
+        hdr.msg_iov = &iov;
+        hdr.msg_iovlen = 1;
+        EXPECT_EQ(static_cast<ssize_t>(msgs.size()), ::sendmsg(fd, &hdr, 0));
+    }
+
+    std::string recv(int fd, size_t size = 8192, int* flags = nullptr)
+    {
+        std::string ret(size, '\0');
+        iovec iov{};
+        iov.iov_base = ret.data();
+        iov.iov_len = ret.size();
+        msghdr hdr{};
+        hdr.msg_iov = &iov;
+        hdr.msg_iovlen = 1;
+        auto len = ::recvmsg(fd, &hdr, 0);
+        if (len < 0)
+        {
+            throw std::system_error(errno, std::generic_category());
+        }
+        ret.resize(len);
+        if (flags != nullptr)
+        {
+            *flags = hdr.msg_flags;
+        }
+        return ret;
+    }
+
+    /** @brief Sends the request and returns the error code of its ack */
+    int request(int fd, const MsgBuilder& b)
+    {
+        send(fd, b.msgs());
+        auto reply = recv(fd);
+        auto hdr = stdplus::raw::copyFrom<nlmsghdr>(reply);
+        EXPECT_EQ(NLMSG_ERROR, hdr.nlmsg_type);
+        std::string_view payload(reply);
+        payload.remove_prefix(NLMSG_HDRLEN);
+        return stdplus::raw::copyFrom<nlmsgerr>(payload).error;
+    }
+
+    static InterfaceInfo ether(unsigned idx)
+    {
+        return InterfaceInfo{.type = ARPHRD_ETHER,
+                             .idx = idx,
+                             .flags = IFF_UP,
+                             .name = std::format("eth{}", idx),
+                             .mac = stdplus::EtherAddr{2, 0, 0, 0, 0,
+                                                       uint8_t(idx)},
+                             .mtu = 1500};
+    }
+
+    static AddressInfo addr4(unsigned idx, uint8_t last)
+    {
+        return AddressInfo{
+            .ifidx = idx,
+            .ifaddr = stdplus::SubnetAny{stdplus::In4Addr{10, 0, 0, last}, 24},
+            .scope = RT_SCOPE_UNIVERSE,
+            .flags = IFA_F_PERMANENT};
+    }
+
+    static MsgBuilder& addrRequest(MsgBuilder& b, uint16_t type,
+                                   uint16_t flags, const AddressInfo& info)
+    {
+        ifaddrmsg ifa{};
+        ifa.ifa_family = AF_INET;
+        ifa.ifa_prefixlen = info.ifaddr.getPfx();
+        ifa.ifa_index = info.ifidx;
+        auto addr = std::get<stdplus::In4Addr>(info.ifaddr.getAddr());
+        return b.begin(type, NLM_F_REQUEST | NLM_F_ACK | flags, 1)
+            .data(ifa)
+            .attr(IFA_ADDRESS, addr)
+            .end();
+    }
+};
+
+TEST_F(FakeKernelTest, DumpSplitAcrossDatagrams)
+{
+    for (unsigned i = 1; i <= 200; ++i)
+    {
+        kernel.addLink(ether(i));
+    }
+    kernel.setDumpDatagramSize(1024);
+
+    std::vector<InterfaceInfo> links;
+    size_t datagrams = 0;
+    ifinfomsg msg{};
+    netlink::performRequest(
+        NETLINK_ROUTE, RTM_GETLINK, NLM_F_DUMP, msg,
+        [&](const nlmsghdr& hdr, std::string_view data) {
+            EXPECT_EQ(RTM_NEWLINK, hdr.nlmsg_type);
+            links.push_back(netlink::intfFromRtm(data));
+        },
+        [&](std::string_view dgram) {
+            EXPECT_GE(1024, dgram.size());
+            datagrams++;
+        });
+    ASSERT_EQ(200, links.size());
+    EXPECT_EQ(ether(1), links.front());
+    EXPECT_EQ(ether(200), links.back());
+    EXPECT_LT(10, datagrams);
+}
+
+TEST_F(FakeKernelTest, DumpInterrupted)
+{
+    kernel.addLink(ether(1));
+    kernel.addAddress(addr4(1, 1));
+    kernel.setDumpInterrupted(true);
+
+    auto fd = open();
+    ifaddrmsg ifa{};
+    MsgBuilder b;
+    b.begin(RTM_GETADDR, NLM_F_REQUEST | NLM_F_DUMP, 7).data(ifa).end();
+    send(fd, b.msgs());
+
+    std::string_view msgs;
+    auto dgram = recv(fd);
+    msgs = dgram;
+    size_t count = 0;
+    while (!msgs.empty())
+    {
+        auto hdr = stdplus::raw::copyFrom<nlmsghdr>(msgs);
+        EXPECT_TRUE(hdr.nlmsg_flags & NLM_F_DUMP_INTR);
+        EXPECT_EQ(7, hdr.nlmsg_seq);
+        msgs.remove_prefix(NLMSG_ALIGN(hdr.nlmsg_len));
+        count++;
+    }
+    EXPECT_EQ(2, count);
+}
+
+TEST_F(FakeKernelTest, AddressWrites)
+{
+    kernel.addLink(ether(1));
+    auto fd = open();
+    MsgBuilder b;
+
+    addrRequest(b, RTM_NEWADDR, NLM_F_CREATE | NLM_F_EXCL, addr4(1, 5));
+    EXPECT_EQ(0, request(fd, b));
+    ASSERT_EQ(1, kernel.getAddresses().size());
+    EXPECT_EQ(addr4(1, 5).ifaddr,
+              kernel.getAddresses().begin()->second.ifaddr);
+    EXPECT_EQ(-EEXIST, request(fd, b));
+
+    b.clear();
+    addrRequest(b, RTM_NEWADDR, NLM_F_CREATE, addr4(2, 5));
+    EXPECT_EQ(-ENODEV, request(fd, b));
+
+    b.clear();
+    addrRequest(b, RTM_DELADDR, 0, addr4(1, 5));
+    EXPECT_EQ(0, request(fd, b));
+    EXPECT_TRUE(kernel.getAddresses().empty());
+    EXPECT_EQ(-EADDRNOTAVAIL, request(fd, b));
+    EXPECT_EQ(0, kernel.pending(fd));
+}
+
+TEST_F(FakeKernelTest, NotifiesSubscribers)
+{
+    auto links = open(RTMGRP_LINK);
+    auto addrs = open();
+    unsigned group = RTNLGRP_IPV4_IFADDR;
+    ASSERT_EQ(0, ::setsockopt(addrs, SOL_NETLINK, NETLINK_ADD_MEMBERSHIP,
+                              &group, sizeof(group)));
+    auto none = open();
+
+    kernel.addLink(ether(1));
+    kernel.addAddress(addr4(1, 1));
+    EXPECT_EQ(1, kernel.pending(links));
+    EXPECT_EQ(1, kernel.pending(addrs));
+    EXPECT_EQ(0, kernel.pending(none));
+
+    std::vector<InterfaceInfo> seen;
+    netlink::receive(links, [&](const nlmsghdr& hdr, std::string_view data) {
+        EXPECT_EQ(RTM_NEWLINK, hdr.nlmsg_type);
+        seen.push_back(netlink::intfFromRtm(data));
+    });
+    ASSERT_EQ(1, seen.size());
+    EXPECT_EQ(ether(1), seen[0]);
+
+    // Deleting the link takes its address along
+    kernel.removeLink(1);
+    EXPECT_EQ(1, kernel.pending(links));
+    EXPECT_EQ(2, kernel.pending(addrs));
+    EXPECT_TRUE(kernel.getAddresses().empty());
+}
+
+TEST_F(FakeKernelTest, VlanCreateEcho)
+{
+    kernel.addLink(ether(1));
+    auto watcher = open(RTMGRP_LINK);
+    auto fd = open(RTMGRP_LINK);
+
+    ifinfomsg ifi{};
+    MsgBuilder b;
+    b.begin(RTM_NEWLINK,
+            NLM_F_REQUEST | NLM_F_ACK | NLM_F_CREATE | NLM_F_EXCL |
+                NLM_F_ECHO,
+            3)
+        .data(ifi)
+        .str(IFLA_IFNAME, "eth1.10")
+        .attr(IFLA_LINK, 1u)
+        .nest(IFLA_LINKINFO)
+        .str(IFLA_INFO_KIND, "vlan")
+        .nest(IFLA_INFO_DATA)
+        .attr(IFLA_VLAN_ID, uint16_t{10})
+        .endNest()
+        .endNest()
+        .end();
+    send(fd, b.msgs());
+
+    // The requester gets a single echo followed by the ack
+    ASSERT_EQ(2, kernel.pending(fd));
+    auto echo = recv(fd);
+    auto hdr = stdplus::raw::copyFrom<nlmsghdr>(echo);
+    EXPECT_EQ(3, hdr.nlmsg_seq);
+    auto info = netlink::intfFromRtm(
+        std::string_view(echo).substr(NLMSG_HDRLEN));
+    EXPECT_EQ(2, info.idx);
+    EXPECT_EQ("vlan", info.kind);
+    EXPECT_EQ(10, info.vlan_id);
+    EXPECT_EQ(1, info.parent_idx);
+    EXPECT_EQ(ether(1).mac, info.mac);
+    recv(fd);
+    EXPECT_EQ(1, kernel.pending(watcher));
+
+    // Stacked devices go away with their parent
+    kernel.removeLink(1);
+    EXPECT_TRUE(kernel.getLinks().empty());
+    EXPECT_EQ(3, kernel.pending(watcher));
+}
+
+TEST_F(FakeKernelTest, CreateVLAN)
+{
+    kernel.addLink(ether(1));
+
+    auto info = createVLAN(1, "eth1.10", 10);
+    EXPECT_EQ(2, info.idx);
+    EXPECT_EQ("eth1.10", info.name);
+
+    // Without the echo the link is looked up by its name
+    kernel.setLinkEcho(false);
+    info = createVLAN(1, "eth1.11", 11);
+    EXPECT_EQ(3, info.idx);
+    EXPECT_EQ(11, info.vlan_id);
+
+    // The kernel's errno is passed on
+    try
+    {
+        createVLAN(1, "eth1.11", 11);
+        ADD_FAILURE() << "Created a duplicate link";
+    }
+    catch (const std::system_error& e)
+    {
+        EXPECT_EQ(std::errc::file_exists, e.code());
+    }
+    try
+    {
+        createVLAN(9, "eth9.12", 12);
+        ADD_FAILURE() << "Created a link without parent";
+    }
+    catch (const std::system_error& e)
+    {
+        EXPECT_EQ(std::errc::no_such_device, e.code());
+    }
+    EXPECT_EQ(3, kernel.getLinks().size());
+}
+
+TEST_F(FakeKernelTest, ReceiveBufferOverrun)
+{
+    auto fd = open(RTMGRP_LINK);
+    kernel.setRcvbuf(fd, 1);
+    kernel.addLink(ether(1));
+    EXPECT_EQ(0, kernel.pending(fd));
+    EXPECT_EQ(1, kernel.dropped(fd));
+    try
+    {
+        netlink::receive(fd, [](const nlmsghdr&, std::string_view) {});
+        ADD_FAILURE() << "Expected ENOBUFS";
+    }
+    catch (const std::system_error& e)
+    {
+        EXPECT_EQ(ENOBUFS, e.code().value());
+    }
+    EXPECT_EQ(0, netlink::receive(fd, [](const nlmsghdr&,
+                                         std::string_view) {}));
+
+    kernel.setRcvbuf(fd, 1 << 20);
+    kernel.addLink(ether(2));
+    kernel.overflow(fd);
+    EXPECT_THROW(recv(fd), std::system_error);
+    EXPECT_EQ(2, kernel.dropped(fd));
+    EXPECT_EQ(1, kernel.pending(fd));
+}
+
+TEST_F(FakeKernelTest, TruncatedRead)
+{
+    auto fd = open(RTMGRP_LINK);
+    kernel.addLink(ether(1));
+    kernel.truncateNext(fd, 16);
+    int flags = 0;
+    EXPECT_EQ(16, recv(fd, 8192, &flags).size());
+    EXPECT_TRUE(flags & MSG_TRUNC);
+
+    kernel.addLink(ether(2));
+    EXPECT_EQ(16, recv(fd, 16, &flags).size());
+    EXPECT_TRUE(flags & MSG_TRUNC);
+
+    kernel.addLink(ether(3));
+    EXPECT_LT(16, recv(fd, 8192, &flags).size());
+    EXPECT_FALSE(flags & MSG_TRUNC);
+}
+
+} // namespace phosphor::network::system
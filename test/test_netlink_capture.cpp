@@ -0,0 +1,86 @@
+#include "netlink_capture.hpp"
+
+#include <stdplus/gtest/tmp.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+namespace phosphor
+{
+namespace network
+{
+namespace netlink
+{
+
+using std::literals::string_view_literals::operator""sv;
+
+class TestCapture : public stdplus::gtest::TestWithTmp
+{
+  protected:
+    std::string path = std::format("{}/netlink.pcap", CaseTmpDir());
+};
+
+TEST_F(TestCapture, RoundTrip)
+{
+    auto t0 = std::chrono::system_clock::time_point(
+        std::chrono::seconds(1700000000) + std::chrono::nanoseconds(123));
+    {
+        Capture capture(path);
+        capture.record("first"sv, t0);
+        capture.record(""sv, t0 + std::chrono::milliseconds(5));
+        capture.record("third datagram"sv, t0 + std::chrono::seconds(2));
+    }
+
+    CaptureReader reader(path);
+    auto d = reader.next();
+    ASSERT_TRUE(d);
+    EXPECT_EQ(t0.time_since_epoch(), d->time);
+    EXPECT_EQ("first", d->data);
+    d = reader.next();
+    ASSERT_TRUE(d);
+    EXPECT_EQ(std::chrono::milliseconds(5), d->time - t0.time_since_epoch());
+    EXPECT_EQ("", d->data);
+    d = reader.next();
+    ASSERT_TRUE(d);
+    EXPECT_EQ(std::chrono::seconds(2), d->time - t0.time_since_epoch());
+    EXPECT_EQ("third datagram", d->data);
+    EXPECT_FALSE(reader.next());
+}
+
+TEST_F(TestCapture, LinkType)
+{
+    Capture{path};
+    std::ifstream in(path, std::ios::binary);
+    char hdr[24];
+    ASSERT_TRUE(in.read(hdr, sizeof(hdr)));
+    uint32_t linktype;
+    std::memcpy(&linktype, hdr + 20, sizeof(linktype));
+    EXPECT_EQ(linktypeNetlink, linktype);
+}
+
+TEST_F(TestCapture, NotPcap)
+{
+    std::ofstream(path) << "not a capture at all, really";
+    EXPECT_THROW(CaptureReader{path}, std::runtime_error);
+}
+
+TEST_F(TestCapture, Truncated)
+{
+    {
+        Capture capture(path);
+        capture.record("datagram"sv);
+    }
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    CaptureReader reader(path);
+    EXPECT_THROW(reader.next(), std::runtime_error);
+}
+
+} // namespace netlink
+} // namespace network
+} // namespace phosphor
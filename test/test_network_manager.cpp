@@ -1,7 +1,13 @@
 #include "test_network_manager.hpp"
 
 #include "config_parser.hpp"
+#include "fake_kernel.hpp"
+#include "statistics.hpp"
 
+#include <linux/if_addr.h>
+#include <linux/neighbour.h>
+#include <linux/rtnetlink.h>
+#include <net/if.h>
 #include <net/if_arp.h>
 
 #include <sdbusplus/bus.hpp>
@@ -18,6 +24,8 @@ namespace network
 
 using ::testing::Key;
 using ::testing::UnorderedElementsAre;
+using stdplus::operator""_ip;
+using stdplus::operator""_sub;
 
 class TestNetworkManager : public stdplus::gtest::TestWithTmp
 {
@@ -91,5 +99,390 @@ TEST_F(TestNetworkManager, WithVLAN)
     EXPECT_TRUE(std::filesystem::is_regular_file(netdev2));
 }
 
+TEST_F(TestNetworkManager, ObjectCounts)
+{
+    auto before = stats::get().objectSnapshot();
+    manager.addInterface(
+        {.type = ARPHRD_ETHER, .idx = 1, .flags = 0, .name = "eth0"});
+    manager.handleAdminState("managed", 1);
+    manager.vlan("eth0", 2);
+
+    auto after = stats::get().objectSnapshot();
+    EXPECT_EQ(before["EthernetInterface"] + 2, after["EthernetInterface"]);
+    EXPECT_EQ(before["DHCPConfiguration"] + 4, after["DHCPConfiguration"]);
+    EXPECT_EQ(before["VLAN"] + 1, after["VLAN"]);
+
+    deleteVLAN("eth0.2");
+    after = stats::get().objectSnapshot();
+    EXPECT_EQ(before["EthernetInterface"] + 1, after["EthernetInterface"]);
+    EXPECT_EQ(before["VLAN"], after["VLAN"]);
+}
+
+TEST_F(TestNetworkManager, StateFollowsPublication)
+{
+    manager.addInterface(
+        {.type = ARPHRD_ETHER, .idx = 1, .flags = 0, .name = "eth0"});
+    AddressInfo addr1{
+        .ifidx = 1,
+        .ifaddr = stdplus::SubnetAny{stdplus::In4Addr{10, 0, 0, 1}, 24},
+        .scope = RT_SCOPE_UNIVERSE,
+        .flags = IFA_F_PERMANENT};
+    auto addr2 = addr1;
+    addr2.ifaddr = stdplus::SubnetAny{stdplus::In4Addr{10, 0, 0, 2}, 24};
+    manager.addAddress(addr1);
+    manager.addAddress(addr2);
+    manager.removeAddress(addr2);
+
+    // Held by the manager until published, then only by the interface
+    manager.handleAdminState("managed", 1);
+    EXPECT_THAT(manager.interfaces.at("eth0")->addrs,
+                UnorderedElementsAre(Key(addr1.ifaddr)));
+
+    // A rename republishes the interface along with its addresses
+    manager.addInterface(
+        {.type = ARPHRD_ETHER, .idx = 1, .flags = 0, .name = "eth1"});
+    EXPECT_THAT(manager.interfaces, UnorderedElementsAre(Key("eth1")));
+    EXPECT_THAT(manager.interfaces.at("eth1")->addrs,
+                UnorderedElementsAre(Key(addr1.ifaddr)));
+
+    // Removing a link by a name bound to another one leaves it be
+    manager.removeInterface(
+        {.type = ARPHRD_ETHER, .idx = 2, .flags = 0, .name = "eth1"});
+    EXPECT_THAT(manager.interfaces, UnorderedElementsAre(Key("eth1")));
+
+    manager.removeInterface(
+        {.type = ARPHRD_ETHER, .idx = 1, .flags = 0, .name = "eth1"});
+    EXPECT_TRUE(manager.interfaces.empty());
+}
+
+TEST_F(TestNetworkManager, Rename)
+{
+    system::FakeKernel kernel;
+    InterfaceInfo eth0{.type = ARPHRD_ETHER, .idx = 1, .flags = 0,
+                       .name = "eth0"};
+    kernel.addLink(eth0);
+    manager.addInterface(eth0);
+    manager.handleAdminState("managed", 1);
+    AddressInfo addr{
+        .ifidx = 1,
+        .ifaddr = stdplus::SubnetAny{stdplus::In4Addr{10, 0, 0, 1}, 24},
+        .scope = RT_SCOPE_UNIVERSE,
+        .flags = IFA_F_PERMANENT};
+    manager.addAddress(addr);
+    manager.addNeighbor(
+        NeighborInfo{.ifidx = 1,
+                     .state = NUD_PERMANENT,
+                     .addr = stdplus::In4Addr{10, 0, 0, 2},
+                     .mac = stdplus::EtherAddr{2, 0, 0, 0, 0, 2}});
+    manager.addDefGw(1, stdplus::In4Addr{10, 0, 0, 254});
+    manager.interfaces.at("eth0")->route("10.1.0.0", 16, "10.0.0.1", 0);
+
+    config::Parser conf;
+    conf.map["Network"].emplace_back()["DHCP"].emplace_back("false");
+    conf.writeFile(config::pathForIntfConf(CaseTmpDir(), "eth1"));
+
+    auto before = stats::get().objectSnapshot();
+    manager.addInterface(
+        {.type = ARPHRD_ETHER, .idx = 1, .flags = 0, .name = "eth1"});
+    auto after = stats::get().objectSnapshot();
+    EXPECT_EQ(before, after);
+
+    // The kernel state carries over, the settings follow the new name
+    ASSERT_THAT(manager.interfaces, UnorderedElementsAre(Key("eth1")));
+    auto& intf = *manager.interfaces.at("eth1");
+    EXPECT_EQ(&intf, manager.links.at(1).intf);
+    ASSERT_THAT(intf.addrs, UnorderedElementsAre(Key(addr.ifaddr)));
+    EXPECT_TRUE(intf.addrs.begin()->second->getObjPath().str.starts_with(
+        "/xyz/openbmc_test/abc/eth1/"));
+    EXPECT_THAT(intf.staticNeighbors,
+                UnorderedElementsAre(Key(stdplus::In4Addr{10, 0, 0, 2})));
+    EXPECT_EQ("10.0.0.254", intf.defaultGateway());
+    ASSERT_THAT(intf.staticRoutes,
+                UnorderedElementsAre(Key("10.1.0.0/16"_sub)));
+    EXPECT_TRUE(intf.staticRoutes.begin()->second->getObjPath().str.starts_with(
+        "/xyz/openbmc_test/abc/eth1/"));
+    EXPECT_EQ("10.0.0.1", intf.staticRoutes.begin()->second->gateway());
+    EXPECT_FALSE(intf.dhcp4());
+    EXPECT_FALSE(intf.dhcp6());
+
+    // The objects of the link are bound to the new parent
+    EXPECT_CALL(manager.mockReload, schedule());
+    intf.addrs.begin()->second->delete_();
+    EXPECT_TRUE(intf.addrs.empty());
+}
+
+TEST_F(TestNetworkManager, VlanChildren)
+{
+    manager.addInterface(
+        {.type = ARPHRD_ETHER, .idx = 1, .flags = 0, .name = "eth0"});
+    manager.handleAdminState("managed", 1);
+    manager.vlan("eth0", 4094);
+    manager.vlan("eth0", 2);
+    EXPECT_EQ(2, manager.vlanChildren.at(1).size());
+
+    auto parentConf = config::pathForIntfConf(CaseTmpDir(), "eth0");
+    EXPECT_EQ((std::vector<std::string>{"eth0.2", "eth0.4094"}),
+              config::Parser(parentConf).map.getValueStrings("Network",
+                                                             "VLAN"));
+
+    deleteVLAN("eth0.2");
+    EXPECT_EQ(std::vector<std::string>{"eth0.4094"},
+              config::Parser(parentConf).map.getValueStrings("Network",
+                                                             "VLAN"));
+    deleteVLAN("eth0.4094");
+    EXPECT_FALSE(manager.vlanChildren.contains(1));
+}
+
+TEST_F(TestNetworkManager, BulkVLAN)
+{
+    manager.addInterface(
+        {.type = ARPHRD_ETHER, .idx = 1, .flags = 0, .name = "eth0"});
+    manager.handleAdminState("managed", 1);
+    EXPECT_THROW(manager.createVLANs("eth1", {{2, 3}}), std::exception);
+    EXPECT_THROW(manager.createVLANs("eth0", {{2, 3}, {0, 1}}),
+                 std::exception);
+    EXPECT_THROW(manager.createVLANs("eth0", {{3, 2}}), std::exception);
+    EXPECT_THROW(manager.createVLANs("eth0", {{4090, 4095}}),
+                 std::exception);
+    EXPECT_THROW(manager.createVLANs("eth0", {}), std::exception);
+    EXPECT_THROW(manager.deleteVLANs("eth0", {}), std::exception);
+    EXPECT_THAT(manager.interfaces, UnorderedElementsAre(Key("eth0")));
+
+    // Overlapping ranges are merged and the batch is reloaded once
+    EXPECT_CALL(manager.mockReload, schedule()).Times(1);
+    auto paths = manager.createVLANs("eth0", {{10, 12}, {2, 2}, {11, 13}});
+    testing::Mock::VerifyAndClearExpectations(&manager.mockReload);
+    EXPECT_EQ(5, paths.size());
+    EXPECT_EQ(5, manager.vlanChildren.at(1).size());
+    auto parentConf = config::pathForIntfConf(CaseTmpDir(), "eth0");
+    EXPECT_EQ((std::vector<std::string>{"eth0.10", "eth0.11", "eth0.12",
+                                        "eth0.13", "eth0.2"}),
+              config::Parser(parentConf).map.getValueStrings("Network",
+                                                             "VLAN"));
+
+    // A single existing or missing VLAN fails the whole batch
+    EXPECT_THROW(manager.createVLANs("eth0", {{13, 14}}), std::exception);
+    EXPECT_FALSE(manager.interfaces.contains("eth0.14"));
+    EXPECT_THROW(manager.deleteVLANs("eth0", {{2, 3}}), std::exception);
+    EXPECT_EQ(5, manager.vlanChildren.at(1).size());
+
+    EXPECT_CALL(manager.mockReload, schedule()).Times(1);
+    manager.deleteVLANs("eth0", {{10, 12}});
+    testing::Mock::VerifyAndClearExpectations(&manager.mockReload);
+    EXPECT_THAT(manager.interfaces, UnorderedElementsAre(Key("eth0"),
+                                                         Key("eth0.2"),
+                                                         Key("eth0.13")));
+    EXPECT_FALSE(std::filesystem::is_regular_file(
+        config::pathForIntfDev(CaseTmpDir(), "eth0.10")));
+    EXPECT_EQ((std::vector<std::string>{"eth0.13", "eth0.2"}),
+              config::Parser(parentConf).map.getValueStrings("Network",
+                                                             "VLAN"));
+}
+
+TEST_F(TestNetworkManager, DirectVLAN)
+{
+    system::FakeKernel kernel;
+    InterfaceInfo eth0{.type = ARPHRD_ETHER,
+                       .idx = 1,
+                       .flags = 0,
+                       .name = "eth0",
+                       .mac = stdplus::EtherAddr{2, 0, 0, 0, 0, 1},
+                       .mtu = 1500};
+    kernel.addLink(eth0);
+    manager.addInterface(eth0);
+    manager.handleAdminState("managed", 1);
+    manager.directVlan = true;
+
+    // The VLAN is bound to its kernel link as soon as it is created
+    manager.vlan("eth0", 2);
+    auto& vlan = manager.interfaces.at("eth0.2");
+    ASSERT_NE(0, vlan->getIfIdx());
+    ASSERT_TRUE(kernel.getLinks().contains(vlan->getIfIdx()));
+    EXPECT_EQ("eth0.2", kernel.getLinks().at(vlan->getIfIdx()).name);
+    EXPECT_EQ(vlan.get(), manager.links.at(vlan->getIfIdx()).intf);
+    EXPECT_TRUE(std::filesystem::is_regular_file(
+        config::pathForIntfDev(CaseTmpDir(), "eth0.2")));
+
+    // A failed link creation takes the rest of the batch back out
+    kernel.addLink({.type = ARPHRD_ETHER,
+                    .idx = 100,
+                    .flags = 0,
+                    .name = "eth0.5"});
+    EXPECT_THROW(manager.createVLANs("eth0", {{3, 3}, {5, 5}}),
+                 std::exception);
+    EXPECT_EQ(3, kernel.getLinks().size());
+    EXPECT_THAT(manager.interfaces,
+                UnorderedElementsAre(Key("eth0"), Key("eth0.2")));
+
+    // Deleting it takes the link down with it, without waiting on a reload.
+    // Its events are ignored until the kernel reports it gone.
+    auto idx = vlan->getIfIdx();
+    deleteVLAN("eth0.2");
+    EXPECT_FALSE(kernel.getLinks().contains(idx));
+    EXPECT_FALSE(manager.links.contains(idx));
+    EXPECT_TRUE(manager.ignoredIntf.contains(idx));
+    manager.removeInterface({.type = ARPHRD_ETHER,
+                             .idx = idx,
+                             .flags = 0,
+                             .name = "eth0.2"});
+    EXPECT_FALSE(manager.ignoredIntf.contains(idx));
+}
+
+TEST_F(TestNetworkManager, NeighborTable)
+{
+    system::FakeKernel kernel;
+    InterfaceInfo eth0{.type = ARPHRD_ETHER, .idx = 1, .flags = 0,
+                       .name = "eth0"};
+    kernel.addLink(eth0);
+    manager.addInterface(eth0);
+    manager.handleAdminState("managed", 1);
+    auto neigh = [](uint8_t last, uint16_t state) {
+        return NeighborInfo{
+            .ifidx = 1,
+            .state = state,
+            .addr = stdplus::In4Addr{10, 0, 0, last},
+            .mac = stdplus::EtherAddr{2, 0, 0, 0, 0, last}};
+    };
+    kernel.addNeighbor(neigh(2, NUD_REACHABLE));
+    kernel.addNeighbor(neigh(1, NUD_STALE));
+
+    // Nothing is kept until the first query
+    manager.addNeighbor(neigh(3, NUD_REACHABLE));
+    EXPECT_EQ(0, manager.getNeighborTable().size());
+
+    auto [page, total] = manager.query("", 0, 10);
+    EXPECT_EQ(2, total);
+    ASSERT_EQ(2, page.size());
+    EXPECT_EQ("eth0", std::get<0>(page[0]));
+    EXPECT_EQ("10.0.0.1", std::get<1>(page[0]));
+    EXPECT_EQ("02:00:00:00:00:01", std::get<2>(page[0]));
+    EXPECT_EQ("STALE", std::get<3>(page[0]));
+    EXPECT_EQ("REACHABLE", std::get<3>(page[1]));
+
+    // Then it follows the kernel events
+    auto incomplete = neigh(3, NUD_INCOMPLETE);
+    incomplete.mac.reset();
+    manager.addNeighbor(incomplete);
+    manager.removeNeighbor(neigh(1, NUD_STALE));
+    std::tie(page, total) = manager.query("eth0", 1, 1);
+    EXPECT_EQ(2, total);
+    ASSERT_EQ(1, page.size());
+    EXPECT_EQ("10.0.0.3", std::get<1>(page[0]));
+    EXPECT_EQ("", std::get<2>(page[0]));
+    EXPECT_EQ("INCOMPLETE", std::get<3>(page[0]));
+
+    EXPECT_THROW(manager.query("eth1", 0, 10), std::exception);
+    manager.removeInterface(eth0);
+    EXPECT_EQ(0, manager.getNeighborTable().size());
+}
+
+TEST_F(TestNetworkManager, RouteLookup)
+{
+    InterfaceInfo eth0{.type = ARPHRD_ETHER, .idx = 1, .flags = IFF_UP,
+                       .name = "eth0"};
+    InterfaceInfo eth1{.type = ARPHRD_ETHER, .idx = 2, .flags = IFF_UP,
+                       .name = "eth1"};
+    manager.addInterface(eth0);
+    manager.addInterface(eth1);
+    manager.handleAdminState("managed", 1);
+    auto addr = [&](unsigned ifidx, stdplus::SubnetAny ifaddr) {
+        manager.addAddress(AddressInfo{.ifidx = ifidx,
+                                       .ifaddr = ifaddr,
+                                       .scope = RT_SCOPE_UNIVERSE,
+                                       .flags = IFA_F_PERMANENT});
+    };
+    addr(1, "10.0.0.5/24"_sub);
+    addr(1, "192.168.1.5/24"_sub);
+    addr(2, "fd00::5/64"_sub);
+    auto route = [](stdplus::SubnetAny dst, unsigned oif,
+                    std::optional<stdplus::InAnyAddr> gw = std::nullopt) {
+        return RouteInfo{.table = RT_TABLE_MAIN,
+                         .protocol = RTPROT_STATIC,
+                         .scope = RT_SCOPE_UNIVERSE,
+                         .type = RTN_UNICAST,
+                         .dst = dst,
+                         .nexthops = {{.oif = oif, .gateway = gw}}};
+    };
+    manager.addRoute(route("0.0.0.0/0"_sub, 1, "192.168.1.1"_ip));
+    manager.addRoute(route("10.0.0.0/24"_sub, 1));
+    auto v6 = route("fd01::/64"_sub, 2, "fd00::1"_ip);
+    v6.prefsrc = "fd00::9"_ip;
+    manager.addRoute(v6);
+    EXPECT_EQ(3, manager.getRouteTable().size());
+
+    EXPECT_EQ(std::tuple("eth0", "192.168.1.1", "192.168.1.5"),
+              manager.lookup("8.8.8.8"));
+    EXPECT_EQ(std::tuple("eth0", "", "10.0.0.5"), manager.lookup("10.0.0.9"));
+    EXPECT_EQ(std::tuple("eth1", "fd00::1", "fd00::9"),
+              manager.lookup("fd01::1"));
+    EXPECT_THROW(manager.lookup("fd02::1"), std::exception);
+    EXPECT_THROW(manager.lookup("not an ip"), std::exception);
+
+    // Downing the link drops its routes, as the kernel does silently
+    eth0.flags = 0;
+    manager.addInterface(eth0);
+    EXPECT_THROW(manager.lookup("8.8.8.8"), std::exception);
+    manager.removeInterface(eth1);
+    EXPECT_EQ(0, manager.getRouteTable().size());
+}
+
+TEST_F(TestNetworkManager, StaticRoutes)
+{
+    system::FakeKernel kernel;
+    InterfaceInfo eth0{.type = ARPHRD_ETHER, .idx = 1, .flags = 0,
+                       .name = "eth0"};
+    kernel.addLink(eth0);
+    manager.addInterface(eth0);
+    manager.handleAdminState("managed", 1);
+    auto& intf = *manager.interfaces.at("eth0");
+    auto routes = [&]() {
+        std::vector<std::string> ret;
+        for (const auto& [key, _] : kernel.getRoutes())
+        {
+            ret.push_back(key);
+        }
+        return ret;
+    };
+    auto conf = config::pathForIntfConf(CaseTmpDir(), "eth0");
+
+    EXPECT_THROW(intf.route("10.1.0.1", 16, "", 0), std::exception);
+    EXPECT_THROW(intf.route("10.1.0.0", 33, "", 0), std::exception);
+    EXPECT_THROW(intf.route("10.1.0.0", 16, "fd00::1", 0), std::exception);
+    EXPECT_THROW(intf.setRoutes({{"10.1.0.0", 16, "", 0},
+                                 {"10.1.0.0", 16, "10.0.0.1", 0}}),
+                 std::exception);
+    EXPECT_TRUE(intf.staticRoutes.empty());
+
+    // The whole batch goes straight to the kernel, without a reload
+    EXPECT_CALL(manager.mockReload, schedule()).Times(0);
+    auto paths = intf.setRoutes({{"10.1.0.0", 16, "10.0.0.1", 0},
+                                 {"fd01::", 64, "", 100}});
+    ASSERT_EQ(2, paths.size());
+    EXPECT_EQ(paths[0], intf.route("10.1.0.0", 16, "10.0.0.1", 0));
+    EXPECT_EQ((std::vector<std::string>{"10/254/fd01::/64/100",
+                                        "2/254/10.1.0.0/16/0"}),
+              routes());
+    EXPECT_EQ((std::vector<std::string>{"10.1.0.0/16", "fd01::/64"}),
+              config::Parser(conf).map.getValueStrings("Route",
+                                                       "Destination"));
+
+    // Changing the metric moves the route, the rest are left alone
+    intf.setRoutes({{"10.1.0.0", 16, "10.0.0.1", 0},
+                    {"fd01::", 64, "", 50},
+                    {"10.2.0.0", 16, "", 0}});
+    EXPECT_EQ((std::vector<std::string>{"10/254/fd01::/64/50",
+                                        "2/254/10.1.0.0/16/0",
+                                        "2/254/10.2.0.0/16/0"}),
+              routes());
+
+    intf.staticRoutes.at("10.1.0.0/16"_sub)->delete_();
+    intf.setRoutes({{"10.2.0.0", 16, "", 0}});
+    EXPECT_EQ((std::vector<std::string>{"2/254/10.2.0.0/16/0"}), routes());
+    EXPECT_EQ(1, intf.staticRoutes.size());
+    EXPECT_EQ((std::vector<std::string>{"10.2.0.0/16"}),
+              config::Parser(conf).map.getValueStrings("Route",
+                                                       "Destination"));
+}
+
 } // namespace network
 } // namespace phosphor
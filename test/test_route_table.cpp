@@ -0,0 +1,126 @@
+#include "route_table.hpp"
+
+#include <linux/rtnetlink.h>
+
+#include <stdplus/net/addr/subnet.hpp>
+
+#include <gtest/gtest.h>
+
+namespace phosphor::network
+{
+
+using stdplus::operator""_sub;
+using stdplus::operator""_ip;
+
+static RouteInfo route(stdplus::SubnetAny dst, unsigned oif,
+                       uint32_t priority = 0,
+                       uint32_t table = RT_TABLE_MAIN,
+                       uint8_t type = RTN_UNICAST)
+{
+    return RouteInfo{.table = table,
+                     .protocol = RTPROT_STATIC,
+                     .scope = RT_SCOPE_UNIVERSE,
+                     .type = type,
+                     .dst = dst,
+                     .priority = priority,
+                     .nexthops = {{.oif = oif}}};
+}
+
+static unsigned oif(const RouteInfo* route)
+{
+    return route == nullptr ? 0 : route->nexthops.front().oif;
+}
+
+TEST(RouteTrie, LongestPrefix)
+{
+    RouteTrie trie;
+    trie.add(route("0.0.0.0/0"_sub, 1));
+    trie.add(route("10.0.0.0/8"_sub, 2));
+    trie.add(route("10.1.0.0/16"_sub, 3));
+    trie.add(route("10.1.2.3/32"_sub, 4));
+    trie.add(route("10.128.0.0/9"_sub, 5));
+    EXPECT_EQ(5, trie.size());
+
+    EXPECT_EQ(1, oif(trie.lookup("192.168.0.1"_ip)));
+    EXPECT_EQ(2, oif(trie.lookup("10.2.0.1"_ip)));
+    EXPECT_EQ(3, oif(trie.lookup("10.1.2.4"_ip)));
+    EXPECT_EQ(4, oif(trie.lookup("10.1.2.3"_ip)));
+    EXPECT_EQ(5, oif(trie.lookup("10.200.0.1"_ip)));
+
+    // Removing the inner prefixes falls back to the shorter ones
+    trie.remove(route("10.1.0.0/16"_sub, 3));
+    trie.remove(route("10.0.0.0/8"_sub, 2));
+    EXPECT_EQ(3, trie.size());
+    EXPECT_EQ(1, oif(trie.lookup("10.1.2.4"_ip)));
+    EXPECT_EQ(4, oif(trie.lookup("10.1.2.3"_ip)));
+    EXPECT_EQ(5, oif(trie.lookup("10.128.0.0"_ip)));
+
+    // Unknown routes are ignored
+    trie.remove(route("10.1.2.0/24"_sub, 3));
+    trie.remove(route("10.1.2.3/32"_sub, 4, 10));
+    EXPECT_EQ(3, trie.size());
+
+    trie.remove(route("0.0.0.0/0"_sub, 1));
+    EXPECT_EQ(0, oif(trie.lookup("192.168.0.1"_ip)));
+}
+
+TEST(RouteTrie, Metrics)
+{
+    RouteTrie trie;
+    trie.add(route("fd00::/64"_sub, 1, 1024));
+    trie.add(route("fd00::/64"_sub, 2, 100));
+    trie.add(route("fd00::/64"_sub, 3, 1024));
+    EXPECT_EQ(2, trie.size());
+    EXPECT_EQ(2, oif(trie.lookup("fd00::1"_ip)));
+
+    trie.remove(route("fd00::/64"_sub, 2, 100));
+    EXPECT_EQ(3, oif(trie.lookup("fd00::1"_ip)));
+    EXPECT_EQ(0, oif(trie.lookup("fd00:0:0:1::1"_ip)));
+}
+
+TEST(RouteTrie, Forget)
+{
+    RouteTrie trie;
+    trie.add(route("10.0.0.0/8"_sub, 1));
+    trie.add(route("10.1.0.0/16"_sub, 2));
+    trie.add(route("10.2.0.0/16"_sub, 2));
+    auto multi = route("10.3.0.0/16"_sub, 2);
+    multi.nexthops.push_back({.oif = 1});
+    trie.add(multi);
+
+    trie.forget(2);
+    EXPECT_EQ(2, trie.size());
+    EXPECT_EQ(1, oif(trie.lookup("10.2.0.1"_ip)));
+    EXPECT_EQ(2, oif(trie.lookup("10.3.0.1"_ip)));
+}
+
+TEST(RouteTable, Lookup)
+{
+    RouteTable table;
+    table.add(route("0.0.0.0/0"_sub, 1));
+    table.add(route("::/0"_sub, 2));
+    table.add(route("10.0.0.5/32"_sub, 3, 0, RT_TABLE_LOCAL, RTN_LOCAL));
+    table.add(route("10.0.0.255/32"_sub, 3, 0, RT_TABLE_LOCAL,
+                    RTN_BROADCAST));
+    table.add(route("192.168.0.0/16"_sub, 0, 0, RT_TABLE_MAIN,
+                    RTN_UNREACHABLE));
+    table.add(route("172.16.0.0/12"_sub, 0, 0, RT_TABLE_MAIN, RTN_THROW));
+    table.add(route("172.16.0.0/12"_sub, 4, 0, RT_TABLE_DEFAULT));
+    table.add(route("10.9.0.0/16"_sub, 5, 0, 1000));
+    EXPECT_EQ(7, table.size());
+
+    EXPECT_EQ(1, oif(table.lookup("10.0.0.1"_ip)));
+    EXPECT_EQ(2, oif(table.lookup("fd00::1"_ip)));
+    EXPECT_EQ(3, oif(table.lookup("10.0.0.5"_ip)));
+    EXPECT_EQ(1, oif(table.lookup("10.0.0.255"_ip)));
+    EXPECT_EQ(nullptr, table.lookup("192.168.1.1"_ip));
+    EXPECT_EQ(4, oif(table.lookup("172.16.0.1"_ip)));
+    // Only the tables of the default rules are consulted
+    EXPECT_EQ(1, oif(table.lookup("10.9.0.1"_ip)));
+
+    table.remove(route("0.0.0.0/0"_sub, 1));
+    EXPECT_EQ(nullptr, table.lookup("10.0.0.1"_ip));
+    EXPECT_EQ(2, oif(table.lookup("fd00::1"_ip)));
+}
+
+} // namespace phosphor::network
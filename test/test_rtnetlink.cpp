@@ -1,3 +1,4 @@
+#include "netlink_msg.hpp"
 #include "rtnetlink.hpp"
 
 #include <linux/netlink.h>
@@ -5,6 +6,11 @@
 
 #include <stdplus/raw.hpp>
 
+#include <array>
+#include <optional>
+#include <string>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 namespace phosphor::network::netlink
@@ -168,4 +174,119 @@ TEST(NeighFromRtm, Full)
     EXPECT_EQ((ether_addr{1, 2, 3, 4, 5, 6}), ret.mac);
 }
 
+static rtmsg rtmOf(uint8_t family, uint8_t dstLen)
+{
+    rtmsg rtm{};
+    rtm.rtm_family = family;
+    rtm.rtm_dst_len = dstLen;
+    rtm.rtm_table = RT_TABLE_MAIN;
+    rtm.rtm_protocol = RTPROT_STATIC;
+    rtm.rtm_scope = RT_SCOPE_UNIVERSE;
+    rtm.rtm_type = RTN_UNICAST;
+    return rtm;
+}
+
+TEST(RouteFromRtm, UnsupportedFamily)
+{
+    MsgBuilder b;
+    b.begin(RTM_NEWROUTE).data(rtmOf(AF_UNSPEC, 0)).end();
+    EXPECT_FALSE(routeFromRtm(b.payload()));
+
+    // Multicast routes come with their own families
+    b.clear();
+    b.begin(RTM_NEWROUTE).data(rtmOf(RTNL_FAMILY_IPMR, 32));
+    b.attr(RTA_DST, std::array<uint8_t, 4>{239, 1, 2, 3});
+    b.end();
+    EXPECT_FALSE(routeFromRtm(b.payload()));
+}
+
+TEST(RouteFromRtm, Default)
+{
+    std::array<uint8_t, 16> gw{0xfe, 0x80};
+    gw[15] = 1;
+    MsgBuilder b;
+    b.begin(RTM_NEWROUTE).data(rtmOf(AF_INET6, 0));
+    b.attr(RTA_TABLE, uint32_t{RT_TABLE_MAIN});
+    b.attr(RTA_GATEWAY, gw);
+    b.attr(RTA_OIF, uint32_t{2});
+    b.end();
+
+    auto ret = routeFromRtm(b.payload()).value();
+    EXPECT_EQ(uint32_t{RT_TABLE_MAIN}, ret.table);
+    EXPECT_EQ("::/0"_sub, ret.dst);
+    EXPECT_EQ(0u, ret.priority);
+    EXPECT_FALSE(ret.prefsrc);
+    EXPECT_EQ((std::vector<RouteInfo::NextHop>{
+                  {.oif = 2, .gateway = "fe80::1"_ip}}),
+              ret.nexthops);
+}
+
+TEST(RouteFromRtm, Prefix)
+{
+    auto rtm = rtmOf(AF_INET, 24);
+    rtm.rtm_table = RT_TABLE_UNSPEC;
+    MsgBuilder b;
+    b.begin(RTM_NEWROUTE).data(rtm);
+    b.attr(RTA_TABLE, uint32_t{1000});
+    b.attr(RTA_DST, std::array<uint8_t, 4>{10, 1, 2, 0});
+    b.attr(RTA_PREFSRC, std::array<uint8_t, 4>{10, 1, 2, 3});
+    b.attr(RTA_PRIORITY, uint32_t{100});
+    b.attr(RTA_OIF, uint32_t{3});
+    b.end();
+
+    auto ret = routeFromRtm(b.payload()).value();
+    EXPECT_EQ(1000u, ret.table);
+    EXPECT_EQ(RTPROT_STATIC, ret.protocol);
+    EXPECT_EQ("10.1.2.0/24"_sub, ret.dst);
+    EXPECT_EQ(100u, ret.priority);
+    EXPECT_EQ("10.1.2.3"_ip, ret.prefsrc);
+    EXPECT_EQ((std::vector<RouteInfo::NextHop>{{.oif = 3}}), ret.nexthops);
+}
+
+/** @brief Appends an rtnexthop with an optional IPv4 gateway */
+static void nexthop(std::string& buf, int ifidx, uint8_t hops,
+                    std::optional<std::array<uint8_t, 4>> gw)
+{
+    rtnexthop nh{};
+    nh.rtnh_len = RTNH_LENGTH(gw ? RTA_LENGTH(sizeof(*gw)) : 0);
+    nh.rtnh_hops = hops;
+    nh.rtnh_ifindex = ifidx;
+    buf.append(reinterpret_cast<const char*>(&nh), sizeof(nh));
+    if (gw)
+    {
+        rtattr hdr{};
+        hdr.rta_type = RTA_GATEWAY;
+        hdr.rta_len = RTA_LENGTH(sizeof(*gw));
+        buf.append(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+        buf.append(reinterpret_cast<const char*>(gw->data()), gw->size());
+    }
+    buf.resize(RTNH_ALIGN(buf.size()), '\0');
+}
+
+TEST(RouteFromRtm, Multipath)
+{
+    std::string hops;
+    nexthop(hops, 2, 0, std::array<uint8_t, 4>{192, 168, 0, 1});
+    nexthop(hops, 3, 2, std::nullopt);
+    MsgBuilder b;
+    b.begin(RTM_NEWROUTE).data(rtmOf(AF_INET, 0));
+    b.attr(RTA_MULTIPATH, std::string_view(hops));
+    b.end();
+
+    auto ret = routeFromRtm(b.payload()).value();
+    EXPECT_EQ("0.0.0.0/0"_sub, ret.dst);
+    EXPECT_EQ((std::vector<RouteInfo::NextHop>{
+                  {.oif = 2, .gateway = "192.168.0.1"_ip, .weight = 1},
+                  {.oif = 3, .weight = 3}}),
+              ret.nexthops);
+
+    // A nexthop claiming more than the attribute holds
+    hops[0] = static_cast<char>(0xff);
+    b.clear();
+    b.begin(RTM_NEWROUTE).data(rtmOf(AF_INET, 0));
+    b.attr(RTA_MULTIPATH, std::string_view(hops));
+    b.end();
+    EXPECT_THROW(routeFromRtm(b.payload()), std::runtime_error);
+}
+
 } // namespace phosphor::network::netlink
@@ -0,0 +1,50 @@
+#include "stall_monitor.hpp"
+
+#include <gtest/gtest.h>
+
+namespace phosphor
+{
+namespace network
+{
+namespace stall
+{
+
+using std::chrono::milliseconds;
+
+TEST(TestStallMonitor, SlowestSorted)
+{
+    Monitor monitor;
+    monitor.setBudget(milliseconds(50));
+
+    monitor.label("netlink", "NEWADDR");
+    monitor.record(milliseconds(10));
+    monitor.label("method", "xyz.openbmc_project.Network.IP.Create", "IP");
+    monitor.record(milliseconds(60));
+    monitor.record(milliseconds(30));
+
+    EXPECT_EQ(1, monitor.getStalls());
+    const auto& slowest = monitor.getSlowest();
+    ASSERT_EQ(3, slowest.size());
+    EXPECT_EQ("method xyz.openbmc_project.Network.IP.Create.IP",
+              slowest[0].source);
+    EXPECT_EQ(milliseconds(60), slowest[0].duration);
+    EXPECT_EQ("event", slowest[1].source);
+    EXPECT_EQ("netlink NEWADDR", slowest[2].source);
+}
+
+TEST(TestStallMonitor, KeepsTopN)
+{
+    Monitor monitor;
+    for (size_t i = 0; i < Monitor::topN * 2; ++i)
+    {
+        monitor.record(milliseconds(i));
+    }
+    const auto& slowest = monitor.getSlowest();
+    ASSERT_EQ(Monitor::topN, slowest.size());
+    EXPECT_EQ(milliseconds(Monitor::topN * 2 - 1), slowest.front().duration);
+    EXPECT_EQ(milliseconds(Monitor::topN), slowest.back().duration);
+}
+
+} // namespace stall
+} // namespace network
+} // namespace phosphor
@@ -0,0 +1,62 @@
+#include "startup.hpp"
+
+#include <gtest/gtest.h>
+
+namespace phosphor
+{
+namespace network
+{
+
+TEST(TestStartup, ReadyAfterSealAndTickets)
+{
+    Startup startup;
+    bool ready = false;
+    startup.onReady([&]() { ready = true; });
+
+    auto a = startup.begin("networkd");
+    auto b = startup.begin("networkd");
+    auto c = startup.begin("hostnamed");
+    ASSERT_EQ(2, startup.getPhases().size());
+    EXPECT_EQ(2, startup.getPhases()[0].pending);
+
+    a.done();
+    startup.seal();
+    EXPECT_FALSE(ready);
+    c.done();
+    EXPECT_FALSE(ready);
+    {
+        auto d = std::move(b);
+    }
+    EXPECT_TRUE(ready);
+    EXPECT_TRUE(startup.isReady());
+    EXPECT_EQ(0, startup.getPhases()[0].pending);
+    EXPECT_EQ(0, startup.getPhases()[1].pending);
+}
+
+TEST(TestStartup, NotReadyBeforeSeal)
+{
+    Startup startup;
+    bool ready = false;
+    startup.onReady([&]() { ready = true; });
+    startup.begin("resolved").done();
+    EXPECT_FALSE(ready);
+    startup.seal();
+    EXPECT_TRUE(ready);
+}
+
+TEST(TestStartup, TicketsAfterReadyIgnored)
+{
+    Startup startup;
+    int ready = 0;
+    startup.onReady([&]() { ready++; });
+    startup.seal();
+    EXPECT_EQ(1, ready);
+    auto t = startup.begin("resolved");
+    EXPECT_TRUE(startup.getPhases().empty());
+    t.done();
+    t.done();
+    EXPECT_EQ(1, ready);
+}
+
+} // namespace network
+} // namespace phosphor
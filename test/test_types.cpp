@@ -1,3 +1,31 @@
 #include "types.hpp"
 
 #include <gtest/gtest.h>
+
+namespace phosphor::network
+{
+
+TEST(InlineString, Basic)
+{
+    IfName empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ("", empty.view());
+    EXPECT_STREQ("", empty.c_str());
+
+    IfName name("eth0");
+    EXPECT_EQ(4, name.size());
+    EXPECT_STREQ("eth0", name.c_str());
+    EXPECT_EQ(name, "eth0");
+    EXPECT_EQ(name, std::string("eth0"));
+    EXPECT_EQ(name, IfName("eth0"));
+    EXPECT_NE(name, IfName("eth1"));
+    EXPECT_NE(name, "eth");
+}
+
+TEST(InlineString, Capacity)
+{
+    EXPECT_EQ(15, IfName("0123456789abcde").size());
+    EXPECT_THROW(IfName("0123456789abcdef"), std::length_error);
+}
+
+} // namespace phosphor::network
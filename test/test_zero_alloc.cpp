@@ -0,0 +1,107 @@
+#include "alloc_count.hpp"
+#include "mock_syscall.hpp"
+#include "netlink_msg.hpp"
+#include "rtnetlink_server.hpp"
+#include "test_network_manager.hpp"
+
+#include <linux/if_addr.h>
+#include <linux/rtnetlink.h>
+#include <net/if.h>
+#include <net/if_arp.h>
+
+#include <sdbusplus/bus.hpp>
+#include <stdplus/gtest/tmp.hpp>
+#include <stdplus/raw.hpp>
+
+#include <gtest/gtest.h>
+
+namespace phosphor
+{
+namespace network
+{
+
+/** @class ZeroAlloc
+ *  @brief Replays kernel events for objects the manager already knows about
+ *         and counts the heap allocations made handling them. This binary
+ *         links the operator new replacement, so it is kept on its own.
+ */
+class ZeroAlloc : public stdplus::gtest::TestWithTmp
+{
+  protected:
+    static constexpr stdplus::EtherAddr mac{2, 0, 0, 0, 0, 1};
+
+    stdplus::Pinned<sdbusplus::bus_t> bus;
+    TestManager manager;
+    netlink::MsgBuilder b;
+
+    ZeroAlloc() :
+        bus(sdbusplus::bus::new_default()),
+        manager(bus, "/xyz/openbmc_test/abc", CaseTmpDir())
+    {
+        InterfaceInfo info{.type = ARPHRD_ETHER,
+                           .idx = 1,
+                           .flags = IFF_UP | IFF_RUNNING,
+                           .name = "eth0",
+                           .mac = mac,
+                           .mtu = 1500};
+        system::mock_clear();
+        system::mock_addIF(info);
+        manager.addInterface(info);
+        manager.handleAdminState("managed", 1);
+    }
+
+    /** @brief Handles the message in the builder, returning the number of
+     *         allocations it took
+     */
+    size_t handle()
+    {
+        auto msg = b.msgs();
+        auto hdr = stdplus::raw::copyFrom<nlmsghdr>(msg);
+        msg = msg.substr(NLMSG_HDRLEN, hdr.nlmsg_len - NLMSG_HDRLEN);
+        auto start = allocations();
+        netlink::handler(manager, hdr, msg);
+        return allocations() - start;
+    }
+};
+
+TEST_F(ZeroAlloc, RepeatedNewLink)
+{
+    ifinfomsg ifi{};
+    ifi.ifi_type = ARPHRD_ETHER;
+    ifi.ifi_index = 1;
+    ifi.ifi_flags = IFF_UP | IFF_RUNNING;
+    b.begin(RTM_NEWLINK)
+        .data(ifi)
+        .str(IFLA_IFNAME, "eth0")
+        .attr(IFLA_ADDRESS, mac)
+        .attr(IFLA_MTU, 1500u)
+        .end();
+
+    handle();
+    EXPECT_EQ(0, handle());
+    ASSERT_EQ(1, manager.interfaces.size());
+    EXPECT_EQ("02:00:00:00:00:01",
+              manager.interfaces.begin()->second->macAddress());
+}
+
+TEST_F(ZeroAlloc, RepeatedNewAddr)
+{
+    ifaddrmsg ifa{};
+    ifa.ifa_family = AF_INET;
+    ifa.ifa_prefixlen = 24;
+    ifa.ifa_scope = RT_SCOPE_UNIVERSE;
+    ifa.ifa_index = 1;
+    b.begin(RTM_NEWADDR)
+        .data(ifa)
+        .attr(IFA_ADDRESS, stdplus::In4Addr{10, 0, 0, 1})
+        .attr(IFA_FLAGS, uint32_t{IFA_F_PERMANENT})
+        .end();
+
+    // The first one creates the address object
+    EXPECT_NE(0, handle());
+    EXPECT_EQ(0, handle());
+    EXPECT_EQ(1, manager.interfaces.begin()->second->addrs.size());
+}
+
+} // namespace network
+} // namespace phosphor